@@ -4,8 +4,12 @@
 #include "commands/commands_core.hpp"
 #include "error_manager.hpp"
 #include "logger.hpp"
+#include "ai_backends.hpp"
+#include "ai_backend.hpp"
+#include "ai_executor.hpp"
+#include "ai_response_cache.hpp"
+#include "ai_context.hpp"
 
-#include <cpr/cpr.h>
 #include <fstream>
 #include <sstream>
 #include <future>
@@ -101,91 +105,44 @@ void setLastCommand(const std::string& command) {
 // Backend resolver
 // =========================================================
 std::string resolveBackendURL() {
-    std::string backend = aiConfig.value("backend", "auto");
-
-    if (backend == "auto") {
-        try {
-            auto r = cpr::Get(cpr::Url{aiConfig.value("ollama_url","http://127.0.0.1:11434") + "/api/tags"},
-                              cpr::Timeout{1000});
-            if (r.status_code == 200) return "ollama";
-        } catch (...) {}
-
-        try {
-            auto r = cpr::Get(cpr::Url{aiConfig.value("localai_url","http://127.0.0.1:8080/v1") + "/models"},
-                              cpr::Timeout{1000});
-            if (r.status_code == 200) return "localai";
-        } catch (...) {}
-
-        return "openai";
-    }
-
-    return backend;
+    // Probing happens once and then in the background (ai_backends.cpp)
+    return BackendRegistry::resolve();
 }
 
 // =========================================================
 // Core async AI call
 // =========================================================
-std::future<std::string> callAIAsync(const std::string& prompt) {
-    return std::async(std::launch::async, [prompt]() -> std::string {
-        std::string backend = resolveBackendURL();
-        std::string model   = aiConfig.value("default_model", "mistral");
-
-        LOG_DEBUG("AI", "callAIAsync backend=" + backend + " model=" + model);
-
-        try {
-            if (backend == "ollama") {
-                auto resp = cpr::Post(
-                    cpr::Url{ aiConfig.value("ollama_url", "http://127.0.0.1:11434") + "/api/generate" },
-                    cpr::Header{{"Content-Type","application/json"}},
-                    cpr::Body{ nlohmann::json{{"model", model}, {"prompt", prompt}}.dump() }
-                );
-                if (resp.status_code == 200) {
-                    auto j = nlohmann::json::parse(resp.text, nullptr, false);
-                    return j.value("response", "");
-                }
-            }
-            else if (backend == "localai" || backend == "openai") {
-                std::string url =
-                    (backend == "localai")
-                        ? aiConfig.value("localai_url","http://127.0.0.1:8080/v1") + "/chat/completions"
-                        : "https://api.openai.com/v1/chat/completions";
-
-                cpr::Header headers = {{"Content-Type","application/json"}};
-                if (backend == "openai") {
-                    auto apiKey = aiConfig["api_keys"].value("openai", "");
-                    if (apiKey.empty()) return "[AI] Missing OpenAI API key";
-                    headers["Authorization"] = "Bearer " + apiKey;
-                }
-
-                auto resp = cpr::Post(
-                    cpr::Url{url},
-                    headers,
-                    cpr::Body{ nlohmann::json{
-                        {"model", model},
-                        {"messages", nlohmann::json::array({
-                            {{"role","user"},{"content",prompt}}
-                        })}
-                    }.dump() }
-                );
-                if (resp.status_code == 200) {
-                    auto j = nlohmann::json::parse(resp.text, nullptr, false);
-                    if (j.contains("choices"))
-                        return j["choices"][0]["message"]["content"].get<std::string>();
-                }
-            }
-        }
-        catch (const std::exception& e) {
-            LOG_ERROR("AI", std::string("Exception: ") + e.what());
-        }
-
+std::future<std::string> callAIAsync(const std::string& prompt,
+                                     const AIExecutor::Request& request,
+                                     bool conversational) {
+    return AIExecutor::submit([prompt, conversational](const AIExecutor::Context& ctx) -> std::string {
+        AIBackend& backend = AIBackend::current(ctx.token);
+        LOG_DEBUG("AI", "callAIAsync backend=" + backend.name());
+
+        // The request timeout never outlives the caller's deadline
+        AIQuery query;
+        query.prompt         = prompt;
+        query.conversational = conversational;
+        query.timeoutMs      = ctx.remainingMs();
+        query.token          = ctx.token;
+
+        AIReply reply = backend.complete(query);
+        if (reply.ok) return reply.text;
+
+        // Aborted by the caller or by our own deadline: says nothing about the backend
+        if (reply.cancelled) return AIExecutor::REPLY_CANCELLED;
+        if (ctx.expired()) return AIExecutor::REPLY_EXPIRED;
+        if (reply.error.rfind("[AI] ", 0) == 0) return reply.error;   // e.g. missing API key
+
+        // A server fault was reported; the next resolve may fail over
         return "[AI] Backend call failed";
-    });
+    }, request);
 }
 
 // =========================================================
 // Blocking AI call → returns CommandResult (with retry)
 // =========================================================
-CommandResult ai_process(const std::string& input) {
+CommandResult ai_process(const std::string& input, const AIExecutor::Request& request) {
     CommandResult result;
     result.category  = "routine";
     result.color     = sf::Color::Cyan;
@@ -195,14 +152,44 @@ CommandResult ai_process(const std::string& input) {
     const int maxRetries = 2;
     std::string reply;
 
-    for (int attempt = 1; attempt <= maxRetries; ++attempt) {
+    // An isolated backend (benchmarks) leaves cache and memory alone
+    AIBackend& current  = AIBackend::current(request.token);
+    std::string backend = current.name();
+    std::string model   = current.model(AIQuery{});
+    bool shared = !current.isolated();
+
+    // Repeat questions are answered locally, but only without context:
+    // "why?" after one exchange means something else after another.
+    // The cache key has no transcript, so neither lookup nor store.
+    bool cacheable = shared && !Conversation::hasContext();
+    if (auto cached = cacheable ? ResponseCache::lookup(input, model, backend) : std::nullopt) {
+        LOG_DEBUG("AI", "Response cache hit");
+        reply = *cached;
+        Conversation::record(input, reply, model);
+        result.success   = true;
+        result.errorCode = "ERR_NONE";
+    }
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (int attempt = 1; attempt <= maxRetries && !result.success; ++attempt) {
         try {
-            auto future = callAIAsync(input);
+            // The retry is queued like any other request, not a new thread
+            auto future = callAIAsync(input, request, true);
             reply = future.get();
 
+            if (AIExecutor::isAborted(reply)) {
+                LOG_DEBUG("AI", "Request not retried: " + reply);
+                break;
+            }
             if (!reply.empty() && reply.rfind("[AI] Backend call failed", 0) != 0) {
                 result.success = true;
                 result.errorCode = "ERR_NONE";
+                // Only real model output; "[AI] ..." notices are not answers
+                if (cacheable && reply.rfind("[AI] ", 0) != 0) {
+                    ResponseCache::store(input, model, backend, reply,
+                                         std::chrono::duration<double, std::milli>(
+                                             std::chrono::steady_clock::now() - t0).count());
+                }
                 break;
             }
 
@@ -214,9 +201,11 @@ CommandResult ai_process(const std::string& input) {
     }
 
     // Memory update
-    longTermMemory["last_input"] = input;
-    longTermMemory["last_reply"] = reply;
-    saveMemory();
+    if (shared) {
+        longTermMemory["last_input"] = input;
+        longTermMemory["last_reply"] = reply;
+        saveMemory();
+    }
 
     result.message = reply.empty() ? "[AI] Failed to process request" : reply;
     result.voice   = result.message;
@@ -226,92 +215,61 @@ CommandResult ai_process(const std::string& input) {
 // =========================================================
 // Streaming / incremental AI call
 // =========================================================
-void ai_process_stream(
-    const std::string& input,
-    nlohmann::json& memory,
-    const std::function<void(const std::string&)>& callback
-) {
-    std::string backend = resolveBackendURL();
-    std::string model   = aiConfig.value("default_model", "mistral");
+// Runs on an executor worker, so it leaves memory alone: the caller
+// records the reply (rememberStreamReply) on its own thread
+static std::string streamOnce(const std::string& input,
+                              const std::function<void(const std::string&)>& callback,
+                              const AIExecutor::Context& ctx) {
+    AIBackend& backend = AIBackend::current(ctx.token);
+    LOG_DEBUG("AI", "ai_process_stream backend=" + backend.name());
+
+    // Tokens reach the callback as the bytes arrive (write callback),
+    // not after the whole body has been received
+    AIQuery query;
+    query.prompt         = input;
+    query.conversational = true;
+    query.timeoutMs      = ctx.remainingMs();
+    query.token          = ctx.token;
+
+    AIReply reply = backend.stream(query, callback);
+    if (!reply.ok && reply.error.rfind("[AI] ", 0) == 0) {
+        if (callback) callback(reply.error + "\n");
+    }
 
-    LOG_DEBUG("AI", "ai_process_stream backend=" + backend + " model=" + model);
+    if (reply.cancelled) return AIExecutor::REPLY_CANCELLED;
+    return reply.ok ? reply.text : "[AI] Stream failed";
+}
 
-    bool success = false;
+void rememberStreamReply(nlohmann::json& memory, const std::string& input, const std::string& reply) {
+    memory["last_input"] = input;
+    bool failed = AIExecutor::isAborted(reply) && reply != AIExecutor::REPLY_CANCELLED;
+    memory["last_reply"] = failed ? "[AI] Stream failed" : reply;
+}
 
-    try {
-        if (backend == "ollama") {
-            auto resp = cpr::Post(
-                cpr::Url{ aiConfig.value("ollama_url", "http://127.0.0.1:11434") + "/api/generate" },
-                cpr::Header{{"Content-Type","application/json"}},
-                cpr::Body{ nlohmann::json{{"model", model}, {"prompt", input}, {"stream", true}}.dump() },
-                cpr::Timeout{60000}
-            );
-            if (resp.status_code == 200) {
-                std::istringstream ss(resp.text);
-                std::string line;
-                while (std::getline(ss, line)) {
-                    if (!line.empty() && callback) callback(line + " ");
-                }
-                success = true;
-            }
-        }
-        else if (backend == "localai" || backend == "openai") {
-            std::string url =
-                (backend == "localai")
-                    ? aiConfig.value("localai_url","http://127.0.0.1:8080/v1") + "/chat/completions"
-                    : "https://api.openai.com/v1/chat/completions";
-
-            cpr::Header headers = {{"Content-Type","application/json"}};
-            if (backend == "openai") {
-                auto apiKey = aiConfig["api_keys"].value("openai", "");
-                if (apiKey.empty()) {
-                    if (callback) callback("[AI] Missing OpenAI API key\n");
-                    LOG_ERROR("AI", "Missing OpenAI API key");
-                    return;
-                }
-                headers["Authorization"] = "Bearer " + apiKey;
-            }
+std::future<std::string> ai_process_stream_async(
+    const std::string& input,
+    std::function<void(const std::string&)> callback,
+    const AIExecutor::Request& request
+) {
+    return AIExecutor::submit(
+        [input, callback = std::move(callback)](const AIExecutor::Context& ctx) {
+            return streamOnce(input, callback, ctx);
+        },
+        request);
+}
 
-            auto resp = cpr::Post(
-                cpr::Url{url},
-                headers,
-                cpr::Body{ nlohmann::json{
-                    {"model", model},
-                    {"stream", true},
-                    {"messages", nlohmann::json::array({
-                        {{"role","user"},{"content",input}}
-                    })}
-                }.dump() },
-                cpr::Timeout{60000}
-            );
-
-            if (resp.status_code == 200) {
-                std::istringstream ss(resp.text);
-                std::string line;
-                while (std::getline(ss, line)) {
-                    if (line.rfind("data:", 0) == 0) {
-                        std::string chunk = line.substr(5);
-                        if (chunk.find("[DONE]") != std::string::npos) break;
-                        auto j = nlohmann::json::parse(chunk, nullptr, false);
-                        if (!j.is_discarded() && j.contains("choices")) {
-                            auto delta = j["choices"][0]["delta"];
-                            if (delta.contains("content")) {
-                                if (callback) callback(delta["content"].get<std::string>());
-                            }
-                        }
-                    }
-                }
-                success = true;
-            }
-        }
-    }
-    catch (const std::exception& e) {
-        LOG_ERROR("AI", std::string("Exception in ai_process_stream: ") + e.what());
+void ai_process_stream(
+    const std::string& input,
+    nlohmann::json& memory,
+    const std::function<void(const std::string&)>& callback,
+    const AIExecutor::Request& request
+) {
+    // Voice replies share the executor's worker cap but jump its queue
+    std::string reply = ai_process_stream_async(input, callback, request).get();
+    if (AIExecutor::isAborted(reply) && reply != AIExecutor::REPLY_CANCELLED) {
+        LOG_DEBUG("AI", "ai_process_stream: " + reply);
     }
-
-    // Memory update
-    memory["last_input"] = input;
-    memory["last_reply"] = success ? "[streamed reply]" : "[AI] Stream failed";
+    rememberStreamReply(memory, input, reply);
 }
 
 // =========================================================
@@ -319,7 +277,8 @@ void ai_process_stream(
 // =========================================================
 void warmupAI() {
     LOG_DEBUG("AI", "Warming up...");
-    auto f = callAIAsync("Hello");
+    // Background: any real request queued meanwhile runs first
+    auto f = callAIAsync("Hello", {AIExecutor::Priority::Background, {}, 30000});
     f.wait();
     LOG_PHASE("AI warmup complete", true);
 }
@@ -4,6 +4,7 @@
 #include <functional>
 #include <nlohmann/json_fwd.hpp>
 #include "commands/commands_core.hpp"
+#include "ai_executor.hpp"
 
 // ------------------------------------------------------------
 // Global AI state (persistent JSON containers)
@@ -45,7 +46,12 @@ std::string resolveBackendURL();
 // ------------------------------------------------------------
 // Core AI calls
 // ------------------------------------------------------------
-std::future<std::string> callAIAsync(const std::string& prompt);
+// Queued on the shared AI executor (ai_executor.hpp); the request
+// carries its priority, cancellation token and deadline.
+// conversational: send and extend the conversation (ai_context.hpp).
+std::future<std::string> callAIAsync(const std::string& prompt,
+                                     const AIExecutor::Request& request = AIExecutor::Request{},
+                                     bool conversational = false);
 
 // Warm up the AI backend at launch to avoid first-call delays.
 void warmupAI();
@@ -53,8 +59,22 @@ void warmupAI();
 // ------------------------------------------------------------
 // Synchronous + streaming AI wrappers
 // ------------------------------------------------------------
-CommandResult ai_process(const std::string& input);
+CommandResult ai_process(const std::string& input,
+                         const AIExecutor::Request& request = {AIExecutor::Priority::Interactive});
 
 void ai_process_stream(const std::string& input,
                        nlohmann::json& memory,
-                       const std::function<void(const std::string&)>& onChunk);
+                       const std::function<void(const std::string&)>& onChunk,
+                       const AIExecutor::Request& request = {AIExecutor::Priority::Interactive});
+
+// Non-blocking variant: the future holds the full reply, or
+// AIExecutor::REPLY_CANCELLED if the request's token was cancelled.
+// onChunk runs on an executor worker. Memory is not touched there:
+// pass the result to rememberStreamReply on the caller's thread.
+std::future<std::string> ai_process_stream_async(
+    const std::string& input,
+    std::function<void(const std::string&)> onChunk,
+    const AIExecutor::Request& request = {AIExecutor::Priority::Interactive});
+
+// last_input / last_reply for a finished stream (aborted → "[AI] Stream failed")
+void rememberStreamReply(nlohmann::json& memory, const std::string& input, const std::string& reply);
@@ -0,0 +1,337 @@
+#include "ai_backend.hpp"
+#include "ai.hpp"
+#include "ai_http.hpp"
+#include "ai_backends.hpp"
+#include "ai_context.hpp"
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+// ---------------- Metrics ----------------
+static std::mutex g_statsMutex;
+static std::map<std::string, AIBackend::Stats> g_stats;
+
+// ---------------- Settings ----------------
+// Copied from aiConfig by configure() on the main thread; requests run
+// on executor workers and read only this copy.
+struct BackendSettings {
+    std::string ollamaUrl    = "http://127.0.0.1:11434";
+    std::string localaiUrl   = "http://127.0.0.1:8080/v1";
+    std::string openaiKey;
+    std::string defaultModel = "mistral";
+};
+static std::mutex      g_settingsMutex;
+static BackendSettings g_settings;
+
+static BackendSettings settings() {
+    std::lock_guard<std::mutex> lock(g_settingsMutex);
+    return g_settings;
+}
+
+// ScopedOverride: requests carrying the token go to the backend
+static std::mutex g_overrideMutex;
+static std::vector<std::pair<AIExecutor::CancelToken, AIBackend*>> g_overrides;
+
+// ============================================================
+// Backends
+// ============================================================
+namespace {
+
+class OllamaBackend : public AIBackend {
+public:
+    explicit OllamaBackend(std::string baseUrl = "")
+        : AIBackend("ollama", std::move(baseUrl)) {}
+
+    std::string model(const AIQuery& query) const override {
+        std::string m = AIBackend::model(query);
+        if (m.find(':') == std::string::npos) m += ":latest";   // default tag
+        return m;
+    }
+
+protected:
+    std::string baseUrl() const override {
+        return baseUrl_.empty() ? settings().ollamaUrl : baseUrl_;
+    }
+    std::string path() const override { return "/api/generate"; }
+    AIStream::Format streamFormat() const override { return AIStream::Format::NDJSON; }
+
+    nlohmann::json body(const AIQuery& query, bool stream) const override {
+        if (query.conversational && !isolated_) {
+            return Conversation::ollamaBody(model(query), query.prompt, stream);
+        }
+        return {{"model", model(query)}, {"prompt", query.prompt}, {"stream", stream}};
+    }
+
+    bool parse(const nlohmann::json& response, std::string& text) const override {
+        if (!response.contains("response") || !response["response"].is_string()) return false;
+        text = response["response"].get<std::string>();
+        return true;
+    }
+};
+
+// OpenAI-compatible chat completions (LocalAI, OpenAI)
+class ChatBackend : public AIBackend {
+public:
+    ChatBackend(std::string name, std::string baseUrl = "")
+        : AIBackend(std::move(name), std::move(baseUrl)) {}
+
+protected:
+    std::string baseUrl() const override {
+        if (!baseUrl_.empty()) return baseUrl_;
+        return name_ == "localai" ? settings().localaiUrl : "https://api.openai.com/v1";
+    }
+    std::string path() const override { return "/chat/completions"; }
+    AIStream::Format streamFormat() const override { return AIStream::Format::SSE; }
+
+    bool headers(cpr::Header& headers, std::string& error) const override {
+        if (name_ != "openai") return true;
+        std::string apiKey = settings().openaiKey;
+        if (!apiKey.empty()) {
+            headers["Authorization"] = "Bearer " + apiKey;
+        } else if (baseUrl_.empty()) {
+            error = "[AI] Missing OpenAI API key";
+            return false;
+        }
+        return true;
+    }
+
+    nlohmann::json body(const AIQuery& query, bool stream) const override {
+        nlohmann::json body = {
+            {"model", model(query)},
+            {"messages", query.conversational && !isolated_
+                ? Conversation::chatMessages(query.prompt)
+                : nlohmann::json::array({{{"role", "user"}, {"content", query.prompt}}})}
+        };
+        if (stream) body["stream"] = true;
+        return body;
+    }
+
+    bool parse(const nlohmann::json& response, std::string& text) const override {
+        if (!response.contains("choices") || !response["choices"].is_array() ||
+            response["choices"].empty()) return false;
+        const auto& message = response["choices"][0].value("message", nlohmann::json::object());
+        if (!message.contains("content") || !message["content"].is_string()) return false;
+        text = message["content"].get<std::string>();
+        return true;
+    }
+};
+
+} // namespace
+
+// ============================================================
+// Shared request path
+// ============================================================
+std::string AIBackend::model(const AIQuery& query) const {
+    return query.model.empty() ? settings().defaultModel : query.model;
+}
+
+void AIBackend::configure(const nlohmann::json& config) {
+    BackendSettings s;
+    if (config.is_object()) {
+        s.ollamaUrl    = config.value("ollama_url", s.ollamaUrl);
+        s.localaiUrl   = config.value("localai_url", s.localaiUrl);
+        s.defaultModel = config.value("default_model", s.defaultModel);
+        if (config.contains("api_keys")) s.openaiKey = config["api_keys"].value("openai", "");
+    }
+    std::lock_guard<std::mutex> lock(g_settingsMutex);
+    g_settings = std::move(s);
+}
+
+bool AIBackend::headers(cpr::Header&, std::string&) const {
+    return true;
+}
+
+AIReply AIBackend::complete(const AIQuery& query) {
+    AIReply reply;
+    auto t0 = std::chrono::steady_clock::now();
+
+    cpr::Header h{{"Content-Type", "application/json"}};
+    if (headers(h, reply.error)) {
+        try {
+            cpr::Response resp = HttpPool::post(baseUrl() + path(), h, body(query, false).dump(),
+                                                query.timeoutMs, nullptr,
+                                                [&query] { return query.token.cancelled(); });
+            reply.status    = resp.status_code;
+            reply.cancelled = query.token.cancelled();
+            if (reply.cancelled) {
+                reply.error = "cancelled";
+            } else if (resp.error) {
+                reply.error = resp.error.message;
+            } else if (resp.status_code != 200) {
+                reply.error = "HTTP " + std::to_string(resp.status_code);
+            } else {
+                auto j = nlohmann::json::parse(resp.text, nullptr, false);
+                if (!j.is_discarded() && parse(j, reply.text)) {
+                    reply.ok    = true;
+                    reply.final = std::move(j);
+                } else {
+                    reply.error = "unexpected response";
+                }
+            }
+        } catch (const std::exception& e) {
+            reply.error = e.what();
+        }
+    }
+
+    reply.totalMs = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - t0).count();
+    finish(query, reply);
+    return reply;
+}
+
+AIReply AIBackend::stream(const AIQuery& query, const AIStream::TokenFn& onToken) {
+    AIReply reply;
+
+    cpr::Header h{{"Content-Type", "application/json"}};
+    if (headers(h, reply.error)) {
+        std::map<std::string, std::string> streamHeaders(h.begin(), h.end());
+        AIStream::Result r = AIStream::post(
+            baseUrl() + path(), streamHeaders, body(query, true).dump(), streamFormat(),
+            [&](const std::string& token) {
+                reply.text += token;
+                if (onToken) onToken(token);
+            },
+            query.timeoutMs, query.token);
+
+        reply.ok        = r.ok;
+        reply.cancelled = r.cancelled;
+        reply.status    = r.status;
+        reply.error     = r.error;
+        reply.ttftMs    = r.ttftMs;
+        reply.totalMs   = r.totalMs;
+        reply.tokens    = r.tokens;
+        reply.final     = std::move(r.final);
+    }
+
+    finish(query, reply);
+    return reply;
+}
+
+std::vector<AIReply> AIBackend::batch(const std::vector<AIQuery>& queries,
+                                      AIExecutor::Priority priority) {
+    std::vector<AIReply> replies(queries.size());
+    std::vector<std::future<std::string>> futures;
+    futures.reserve(queries.size());
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        futures.push_back(AIExecutor::submit(
+            [this, &replies, &queries, i](const AIExecutor::Context& ctx) -> std::string {
+                AIQuery q = queries[i];
+                if (q.timeoutMs <= 0) q.timeoutMs = ctx.remainingMs();
+                replies[i] = complete(q);
+                return replies[i].text;
+            },
+            {priority, queries[i].token}));
+    }
+
+    // Requests the executor never ran report why
+    for (size_t i = 0; i < futures.size(); i++) {
+        std::string result = futures[i].get();
+        if (!replies[i].ok && replies[i].error.empty() && AIExecutor::isAborted(result)) {
+            replies[i].error     = result;
+            replies[i].cancelled = (result == AIExecutor::REPLY_CANCELLED);
+        }
+    }
+    return replies;
+}
+
+// Timing slack when deciding whether a request ran into its deadline
+constexpr double DEADLINE_SLACK_MS = 50.0;
+
+void AIBackend::finish(const AIQuery& query, AIReply& reply) {
+    // A missing key never reached the backend; a cancel is our choice
+    bool reachedBackend = reply.error.rfind("[AI] ", 0) != 0;
+
+    if (reply.ok) {
+        if (!isolated_) BackendRegistry::reportSuccess(name_);
+        if (query.conversational && !isolated_) {
+            Conversation::record(query.prompt, reply.text, model(query), reply.final);
+        }
+    } else if (reachedBackend && !reply.cancelled) {
+        // Only the server's own fault marks it down: no response at
+        // all, or a 5xx. A 4xx (unknown model, bad request) is ours,
+        // and running out of the caller's deadline (timeoutMs is the
+        // executor's remaining time) says nothing about the server.
+        bool deadlineHit = query.timeoutMs > 0 &&
+                           reply.totalMs + DEADLINE_SLACK_MS >= query.timeoutMs;
+        bool serverFault = reply.status >= 500 || (reply.status == 0 && !deadlineHit);
+        if (serverFault && !isolated_) BackendRegistry::reportFailure(name_);
+        LOG_ERROR("AI", name_ + " request failed: " + reply.error +
+                        (serverFault ? "" : " (not counted against its health)"));
+    }
+
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    Stats& s = g_stats[baseUrl_.empty() ? name_ : name_ + " @ " + baseUrl_];
+    s.requests++;
+    if (reply.cancelled) {
+        s.cancelled++;
+    } else if (!reply.ok) {
+        s.failures++;
+    } else {
+        s.totalMs += reply.totalMs;
+    }
+}
+
+// ============================================================
+// Instances
+// ============================================================
+AIBackend& AIBackend::forName(const std::string& name) {
+    static OllamaBackend ollama;
+    static ChatBackend   localai("localai");
+    static ChatBackend   openai("openai");
+
+    if (name == "ollama")  return ollama;
+    if (name == "localai") return localai;
+    return openai;
+}
+
+AIBackend& AIBackend::current() {
+    return forName(BackendRegistry::resolve());
+}
+
+AIBackend& AIBackend::current(const AIExecutor::CancelToken& token) {
+    {
+        std::lock_guard<std::mutex> lock(g_overrideMutex);
+        for (const auto& [t, backend] : g_overrides) {
+            if (t == token) return *backend;
+        }
+    }
+    return current();
+}
+
+AIBackend::ScopedOverride::ScopedOverride(AIBackend& backend, AIExecutor::CancelToken token)
+    : token_(std::move(token)) {
+    std::lock_guard<std::mutex> lock(g_overrideMutex);
+    g_overrides.emplace_back(token_, &backend);
+}
+
+AIBackend::ScopedOverride::~ScopedOverride() {
+    std::lock_guard<std::mutex> lock(g_overrideMutex);
+    std::erase_if(g_overrides, [this](const auto& o) { return o.first == token_; });
+}
+
+std::unique_ptr<AIBackend> AIBackend::create(const std::string& name, const std::string& baseUrl) {
+    std::unique_ptr<AIBackend> backend;
+    if (name == "ollama") {
+        backend = std::make_unique<OllamaBackend>(baseUrl);
+    } else if (name == "localai" || name == "openai") {
+        backend = std::make_unique<ChatBackend>(name, baseUrl);
+    } else {
+        return nullptr;
+    }
+    backend->isolated_ = true;
+    return backend;
+}
+
+std::vector<std::pair<std::string, AIBackend::Stats>> AIBackend::allStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    return { g_stats.begin(), g_stats.end() };
+}
+
+void AIBackend::resetStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    g_stats.clear();
+}
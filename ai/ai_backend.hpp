@@ -0,0 +1,126 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cpr/cpr.h>
+#include <nlohmann/json.hpp>
+#include "ai_executor.hpp"
+#include "ai_stream.hpp"
+
+// ============================================================
+// AIBackend — one request path for every AI backend
+// ============================================================
+// - Subclasses only describe a backend: endpoint, headers, request
+//   body, model naming and how to read a reply. Sending, pooling
+//   (HttpPool), streaming (AIStream), cancellation, health reports
+//   (BackendRegistry), conversation recording and metrics happen
+//   once, here.
+// - Ollama:  /api/generate, NDJSON, untagged models get ":latest".
+// - Chat:    OpenAI-compatible /chat/completions, SSE (LocalAI and
+//            OpenAI; OpenAI needs api_keys.openai).
+// - forName() returns the shared instance configured from
+//   ai_config.json; create() builds an isolated one against another
+//   base URL (e.g. the local stand-in server): no health reports,
+//   no response cache, no conversation context.
+// - ScopedOverride makes current(token) return such a backend for
+//   requests carrying one CancelToken, so the regular entry points
+//   (callAIAsync, ai_process, ...) can be driven against it while
+//   every other request keeps the real backend.
+// ============================================================
+struct AIQuery {
+    std::string prompt;
+    std::string model;                 // empty = "default_model" (configure())
+    bool        conversational = false; // send + extend ai_context.hpp
+    int         timeoutMs      = 0;     // 0 = HttpPool default
+    AIExecutor::CancelToken token;
+};
+
+struct AIReply {
+    bool        ok        = false;
+    bool        cancelled = false;
+    long        status    = 0;
+    std::string text;
+    std::string error;     // "[AI] ..." for configuration problems
+    double      ttftMs    = -1.0;   // streaming only
+    double      totalMs   = 0.0;
+    size_t      tokens    = 0;      // streaming only
+    nlohmann::json final;           // Ollama's last reply object
+};
+
+class AIBackend {
+public:
+    virtual ~AIBackend() = default;
+
+    const std::string& name() const { return name_; }
+
+    // Built by create(): keep its traffic out of shared state
+    bool isolated() const { return isolated_; }
+
+    // Model as sent to this backend (tag normalization applied)
+    virtual std::string model(const AIQuery& query) const;
+
+    // Whole reply in one response
+    AIReply complete(const AIQuery& query);
+
+    // Tokens reach onToken as they arrive
+    AIReply stream(const AIQuery& query, const AIStream::TokenFn& onToken);
+
+    // Run queries concurrently on the AI executor; replies in order
+    std::vector<AIReply> batch(const std::vector<AIQuery>& queries,
+                               AIExecutor::Priority priority = AIExecutor::Priority::Background);
+
+    // Copy URLs, API key and default model from config. Main thread,
+    // once the config is loaded; requests never read aiConfig.
+    static void configure(const nlohmann::json& config);
+
+    // Shared instance for "ollama", "localai" or "openai"
+    static AIBackend& forName(const std::string& name);
+    // The backend resolved right now
+    static AIBackend& current();
+    // The override registered for token, else current()
+    static AIBackend& current(const AIExecutor::CancelToken& token);
+    // Isolated instance against baseUrl; nullptr if name is unknown
+    static std::unique_ptr<AIBackend> create(const std::string& name, const std::string& baseUrl);
+
+    // While alive, current(token) returns backend (not owned)
+    class ScopedOverride {
+    public:
+        ScopedOverride(AIBackend& backend, AIExecutor::CancelToken token);
+        ~ScopedOverride();
+        ScopedOverride(const ScopedOverride&) = delete;
+        ScopedOverride& operator=(const ScopedOverride&) = delete;
+    private:
+        AIExecutor::CancelToken token_;
+    };
+
+    struct Stats {
+        uint64_t requests  = 0;
+        uint64_t failures  = 0;
+        uint64_t cancelled = 0;
+        double   totalMs   = 0.0;   // summed over successful requests
+    };
+    static std::vector<std::pair<std::string, Stats>> allStats();
+    static void resetStats();
+
+protected:
+    AIBackend(std::string name, std::string baseUrl)
+        : name_(std::move(name)), baseUrl_(std::move(baseUrl)) {}
+
+    // baseUrl_ when set, else the one from configure()
+    virtual std::string baseUrl() const = 0;
+    virtual std::string path() const = 0;
+    virtual AIStream::Format streamFormat() const = 0;
+    // False (with error) if the backend cannot be called as configured
+    virtual bool headers(cpr::Header& headers, std::string& error) const;
+    virtual nlohmann::json body(const AIQuery& query, bool stream) const = 0;
+    // Reply text from a buffered response body
+    virtual bool parse(const nlohmann::json& response, std::string& text) const = 0;
+
+    std::string name_;
+    std::string baseUrl_;
+    bool        isolated_ = false;
+
+private:
+    void finish(const AIQuery& query, AIReply& reply);
+};
@@ -0,0 +1,235 @@
+#include "ai_backends.hpp"
+#include "ai.hpp"
+#include "ai_http.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace BackendRegistry {
+
+using Clock = std::chrono::steady_clock;
+
+// ---------------- State ----------------
+struct Entry {
+    Status            status;
+    Clock::time_point nextCheck;
+};
+
+static std::mutex              g_regMutex;
+static std::condition_variable g_regCV;
+static std::vector<Entry>      g_entries;     // local backends, preference order
+static std::thread             g_refreshThread;
+static bool                    g_started  = false;
+static bool                    g_ready    = false;   // first probe pass finished
+static bool                    g_stopping = false;
+
+struct HealthConfig {
+    int refreshMs      = 30000;
+    int backoffMinMs   = 1000;
+    int backoffMaxMs   = 60000;
+    int probeTimeoutMs = 1000;
+};
+
+static HealthConfig loadHealthConfig() {
+    HealthConfig cfg;
+    if (aiConfig.is_object() && aiConfig.contains("backend_health")) {
+        const auto& h = aiConfig["backend_health"];
+        cfg.refreshMs      = h.value("refresh_ms", cfg.refreshMs);
+        cfg.backoffMinMs   = h.value("backoff_min_ms", cfg.backoffMinMs);
+        cfg.backoffMaxMs   = h.value("backoff_max_ms", cfg.backoffMaxMs);
+        cfg.probeTimeoutMs = h.value("probe_timeout_ms", cfg.probeTimeoutMs);
+    }
+    cfg.refreshMs    = std::max(1000, cfg.refreshMs);
+    cfg.backoffMinMs = std::max(100, cfg.backoffMinMs);
+    cfg.backoffMaxMs = std::max(cfg.backoffMinMs, cfg.backoffMaxMs);
+    return cfg;
+}
+
+static std::string probeUrl(const std::string& name) {
+    if (name == "ollama") return aiConfig.value("ollama_url", "http://127.0.0.1:11434") + "/api/tags";
+    return aiConfig.value("localai_url", "http://127.0.0.1:8080/v1") + "/models";
+}
+
+// Caller holds g_regMutex
+static Entry* findLocked(const std::string& name) {
+    for (auto& e : g_entries) {
+        if (e.status.name == name) return &e;
+    }
+    return nullptr;
+}
+
+// Caller holds g_regMutex
+static void markLocked(Entry& e, bool healthy, const HealthConfig& cfg) {
+    Health before = e.status.health;
+    if (healthy) {
+        e.status.health   = Health::Healthy;
+        e.status.failures = 0;
+        e.nextCheck = Clock::now() + std::chrono::milliseconds(cfg.refreshMs);
+    } else {
+        e.status.health = Health::Down;
+        e.status.failures++;
+        long long backoff = static_cast<long long>(cfg.backoffMinMs)
+                            << std::min(e.status.failures - 1, 16);
+        e.nextCheck = Clock::now() +
+                      std::chrono::milliseconds(std::min<long long>(backoff, cfg.backoffMaxMs));
+    }
+    if (before != e.status.health) {
+        LOG_DEBUG("AI", "Backend " + e.status.name + " → " + (healthy ? "healthy" : "down"));
+    }
+}
+
+static bool probe(const std::string& name, int timeoutMs, double& elapsedMs) {
+    auto t0 = Clock::now();
+    bool ok = false;
+    try {
+        auto r = HttpPool::get(probeUrl(name), timeoutMs);
+        ok = (r.status_code == 200);
+    } catch (...) {}
+    elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return ok;
+}
+
+static void probeAndMark(const std::string& name, const HealthConfig& cfg) {
+    double ms = 0.0;
+    bool ok = probe(name, cfg.probeTimeoutMs, ms);
+
+    std::lock_guard<std::mutex> lock(g_regMutex);
+    if (Entry* e = findLocked(name)) {
+        e->status.lastProbeMs = ms;
+        markLocked(*e, ok, cfg);
+    }
+}
+
+// ============================================================
+// Background refresh
+// ============================================================
+static void refreshLoop() {
+    std::unique_lock<std::mutex> lock(g_regMutex);
+    while (!g_stopping) {
+        auto next = Clock::time_point::max();
+        for (const auto& e : g_entries) next = std::min(next, e.nextCheck);
+        g_regCV.wait_until(lock, next, [] { return g_stopping; });
+        if (g_stopping) break;
+
+        std::vector<std::string> due;
+        auto now = Clock::now();
+        for (const auto& e : g_entries) {
+            if (e.nextCheck <= now) due.push_back(e.status.name);
+        }
+        if (due.empty()) continue;
+
+        // Probes are blocking HTTP; never hold the lock across them
+        lock.unlock();
+        HealthConfig cfg = loadHealthConfig();
+        for (const auto& name : due) probeAndMark(name, cfg);
+        lock.lock();
+    }
+}
+
+// First auto resolve: probe in preference order until one answers
+// (the old per-call behaviour, paid once), then hand over to the
+// background thread.
+static void ensureStarted() {
+    {
+        std::unique_lock<std::mutex> lock(g_regMutex);
+        if (g_started) {
+            // Concurrent first callers wait for the initial pass
+            g_regCV.wait(lock, [] { return g_ready || g_stopping; });
+            return;
+        }
+        g_started = true;
+        g_entries.clear();
+        for (const char* name : { "ollama", "localai" }) {
+            Entry e;
+            e.status.name = name;
+            e.nextCheck = Clock::now();
+            g_entries.push_back(e);
+        }
+    }
+
+    HealthConfig cfg = loadHealthConfig();
+    for (const char* name : { "ollama", "localai" }) {
+        probeAndMark(name, cfg);
+        std::lock_guard<std::mutex> lock(g_regMutex);
+        if (findLocked(name)->status.health == Health::Healthy) break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_regMutex);
+        g_ready = true;
+        if (!g_stopping) g_refreshThread = std::thread(refreshLoop);
+    }
+    g_regCV.notify_all();
+}
+
+// ============================================================
+// Public API
+// ============================================================
+std::string resolve() {
+    std::string backend = aiConfig.value("backend", "auto");
+    if (backend != "auto") return backend;
+
+    ensureStarted();
+
+    std::lock_guard<std::mutex> lock(g_regMutex);
+    for (const auto& e : g_entries) {
+        if (e.status.health == Health::Healthy) return e.status.name;
+    }
+    return "openai";
+}
+
+void reportSuccess(const std::string& backend) {
+    HealthConfig cfg = loadHealthConfig();
+    std::lock_guard<std::mutex> lock(g_regMutex);
+    if (Entry* e = findLocked(backend)) {
+        if (e->status.health != Health::Healthy) markLocked(*e, true, cfg);
+    }
+}
+
+void reportFailure(const std::string& backend) {
+    HealthConfig cfg = loadHealthConfig();
+    {
+        std::lock_guard<std::mutex> lock(g_regMutex);
+        Entry* e = findLocked(backend);
+        if (!e) return;
+        markLocked(*e, false, cfg);
+    }
+    LOG_ERROR("AI", "Backend " + backend + " failed a request; failing over");
+    g_regCV.notify_all();
+}
+
+void refreshNow() {
+    ensureStarted();
+    HealthConfig cfg = loadHealthConfig();
+    for (const char* name : { "ollama", "localai" }) probeAndMark(name, cfg);
+    g_regCV.notify_all();
+}
+
+std::vector<Status> status() {
+    std::lock_guard<std::mutex> lock(g_regMutex);
+    std::vector<Status> out;
+    auto now = Clock::now();
+    for (const auto& e : g_entries) {
+        Status s = e.status;
+        s.nextCheckMs = std::max<long long>(0, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                   e.nextCheck - now).count());
+        out.push_back(s);
+    }
+    return out;
+}
+
+void shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(g_regMutex);
+        g_stopping = true;
+    }
+    g_regCV.notify_all();
+    if (g_refreshThread.joinable()) g_refreshThread.join();
+}
+
+} // namespace BackendRegistry
@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// ============================================================
+// BackendRegistry — cached backend resolution for "auto"
+// ============================================================
+// - The first resolve probes local backends (Ollama, LocalAI) in
+//   preference order once; after that resolve() is a lookup.
+// - A background thread re-checks health: healthy backends every
+//   refresh_ms, down ones with exponential backoff.
+// - Request failures mark a backend down immediately, so the next
+//   resolve fails over to the next healthy one (OpenAI last).
+// - An explicit "backend" in ai_config.json bypasses all of this.
+// ============================================================
+namespace BackendRegistry {
+    enum class Health { Unknown, Healthy, Down };
+
+    struct Status {
+        std::string name;
+        Health health       = Health::Unknown;
+        int    failures     = 0;      // consecutive
+        double lastProbeMs  = 0.0;    // duration of the last probe
+        long long nextCheckMs = 0;    // until the next background probe
+    };
+
+    // Backend name to use now ("ollama", "localai", "openai")
+    std::string resolve();
+
+    // Outcome of a real request against a backend
+    void reportSuccess(const std::string& backend);
+    void reportFailure(const std::string& backend);
+
+    // Probe every local backend now (blocking)
+    void refreshNow();
+
+    std::vector<Status> status();
+    void shutdown();
+}
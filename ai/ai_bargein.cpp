@@ -0,0 +1,140 @@
+#include "ai_bargein.hpp"
+#include "ai.hpp"
+#include "voice/voice_speak.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <mutex>
+
+namespace BargeIn {
+
+// ---------------- State ----------------
+static std::mutex              g_mutex;
+static AIExecutor::CancelToken g_current;
+static bool                    g_active = false;
+static Stats                   g_stats;
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("barge_in")) {
+        const auto& b = aiConfig["barge_in"];
+        opt.enabled     = b.value("enabled", opt.enabled);
+        opt.minSpeechMs  = b.value("min_speech_ms", opt.minSpeechMs);
+        opt.overPlayback = b.value("over_playback", opt.overPlayback);
+        opt.echoRatio    = b.value("echo_ratio", opt.echoRatio);
+        opt.echoLearnMs  = b.value("echo_learn_ms", opt.echoLearnMs);
+    }
+    opt.minSpeechMs = std::max(0, opt.minSpeechMs);
+    opt.echoRatio   = std::max(1.0f, opt.echoRatio);
+    opt.echoLearnMs = std::max(0, opt.echoLearnMs);
+    return opt;
+}
+
+// ============================================================
+// Gate
+// ============================================================
+// Gaps between sentences keep the echo floor; a longer silence
+// means the next playback may come out louder or softer
+constexpr double ECHO_RESET_MS = 1000.0;
+
+Gate::Gate(const Options& opt) : opt_(opt) {}
+
+bool Gate::process(bool speech, float rms, bool playing, double blockMs) {
+    bool counts = speech;
+
+    if (playing) {
+        quietMs_    = 0.0;
+        playingMs_ += blockMs;
+        if (playingMs_ <= opt_.echoLearnMs) {
+            // The echo's peaks, not its average: TTS syllables vary a lot
+            echoFloor_ = std::max(echoFloor_, rms);
+            counts = false;
+        } else if (rms <= echoFloor_ * opt_.echoRatio) {
+            echoFloor_ += 0.05f * (rms - echoFloor_);
+            counts = false;
+        }
+        if (!opt_.overPlayback) counts = false;
+    } else {
+        quietMs_ += blockMs;
+        if (quietMs_ > ECHO_RESET_MS) {
+            playingMs_ = 0.0;
+            echoFloor_ = 0.0f;
+        }
+    }
+
+    if (!counts) {
+        speechRunMs_ = 0.0;
+        handled_     = false;
+        return false;
+    }
+    speechRunMs_ += blockMs;
+    if (!opt_.enabled || handled_ || speechRunMs_ < opt_.minSpeechMs) return false;
+    handled_ = true;
+    return true;
+}
+
+// ============================================================
+// Turns
+// ============================================================
+AIExecutor::CancelToken beginTurn() {
+    AIExecutor::CancelToken previous, next;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_active) {
+            g_current.cancel();
+            g_stats.superseded++;
+        }
+        previous  = g_current;
+        g_current = next;
+        g_active  = true;
+        g_stats.turns++;
+    }
+    // Sentences of the old reply may still be queued or playing
+    Voice::cancelSpeech(previous);
+    return next;
+}
+
+void endTurn(const AIExecutor::CancelToken& token) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (token == g_current) g_active = false;
+}
+
+bool active() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_active && !g_current.cancelled();
+}
+
+bool interrupt() {
+    bool cancelledReply = false;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_active && !g_current.cancelled()) {
+            g_current.cancel();
+            cancelledReply = true;
+        }
+    }
+
+    size_t flushed = Voice::cancelSpeech();
+    if (!cancelledReply && flushed == 0) return false;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_stats.interrupts++;
+    if (cancelledReply) g_stats.replies++;
+    g_stats.speechFlushed += flushed;
+    LOG_DEBUG("BargeIn", std::string("Interrupted") + (cancelledReply ? " reply" : "") +
+                         (flushed ? ", " + std::to_string(flushed) + " speech item(s)" : ""));
+    return true;
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_stats;
+}
+
+void resetStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_stats = Stats{};
+}
+
+} // namespace BargeIn
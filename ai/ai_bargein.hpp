@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include "ai_executor.hpp"
+
+// ============================================================
+// BargeIn — user speech interrupts the assistant
+// ============================================================
+// - Each user request that ends in an AI reply is a turn with its
+//   own CancelToken; starting a turn cancels the previous one and
+//   whatever of its reply is still queued for speech.
+// - interrupt() (new speech detected) cancels the generating turn
+//   and flushes queued / playing speech, so an outdated reply
+//   stops using the model server and is never spoken.
+// - Gate decides when mic speech is the user: while TTS is audible
+//   the mic also hears the assistant, so speech only counts once it
+//   is well above the echo level learned at playback start.
+// - Tuned by ai_config.json "barge_in".
+// ============================================================
+namespace BargeIn {
+    struct Options {
+        bool  enabled      = true;
+        int   minSpeechMs  = 250;    // continuous speech before interrupting
+        bool  overPlayback = true;   // false: never interrupt while TTS is audible
+        float echoRatio    = 4.0f;   // during playback: rms over the echo floor
+        int   echoLearnMs  = 300;    // playback start: echo only, nothing counts
+    };
+    Options loadOptions();
+
+    // One per capture loop
+    class Gate {
+    public:
+        explicit Gate(const Options& opt = loadOptions());
+
+        // One capture block: the VAD verdict, its RMS and whether TTS
+        // is audible. True once per run of speech that should interrupt.
+        bool process(bool speech, float rms, bool playing, double blockMs);
+
+        float echoFloor() const { return echoFloor_; }
+
+    private:
+        Options opt_;
+        double  speechRunMs_ = 0.0;
+        double  playingMs_   = 0.0;   // audible playback since the echo was reset
+        double  quietMs_     = 0.0;   // since playback was last audible
+        float   echoFloor_   = 0.0f;
+        bool    handled_     = false;
+    };
+
+    // New turn: cancels the one in flight, returns the new turn's token
+    AIExecutor::CancelToken beginTurn();
+
+    // Reply for this turn finished; no-op if a newer turn has begun
+    void endTurn(const AIExecutor::CancelToken& token);
+
+    // A turn is still generating
+    bool active();
+
+    // Cancel the generating turn and pending speech. Returns true if
+    // anything was actually cut short.
+    bool interrupt();
+
+    struct Stats {
+        uint64_t turns         = 0;
+        uint64_t superseded    = 0;   // turn cancelled by the next turn
+        uint64_t interrupts    = 0;   // interrupt() that cut something
+        uint64_t replies       = 0;   // generations cancelled by speech
+        uint64_t speechFlushed = 0;   // speak() items dropped or stopped
+    };
+    Stats getStats();
+    void  resetStats();
+}
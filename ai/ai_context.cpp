@@ -0,0 +1,182 @@
+#include "ai_context.hpp"
+#include "ai.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+namespace Conversation {
+
+// ---------------- State ----------------
+struct Message {
+    std::string role;   // "user" / "assistant"
+    std::string text;
+    int         tokens = 0;
+};
+
+static std::mutex          g_mutex;
+static std::deque<Message> g_transcript;
+static int                 g_transcriptTokens = 0;
+
+// Ollama KV context covering the transcript, if still in sync
+static nlohmann::json g_context = nlohmann::json::array();
+static std::string    g_contextModel;
+static bool           g_contextValid = false;
+
+static Stats g_stats;
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("conversation")) {
+        const auto& c = aiConfig["conversation"];
+        opt.enabled   = c.value("enabled", opt.enabled);
+        opt.maxTokens = c.value("max_tokens", opt.maxTokens);
+        opt.maxTurns  = c.value("max_turns", opt.maxTurns);
+        opt.reuseKv   = c.value("reuse_kv", opt.reuseKv);
+    }
+    opt.maxTokens = std::max(64, opt.maxTokens);
+    opt.maxTurns  = std::max(0, opt.maxTurns);
+    return opt;
+}
+
+int estimateTokens(const std::string& text) {
+    // Rough BPE average for English; only used for budgeting
+    return static_cast<int>((text.size() + 3) / 4);
+}
+
+// ============================================================
+// Transcript (caller holds g_mutex)
+// ============================================================
+// Drop the oldest messages until the transcript plus `reserve`
+// tokens fits the budget
+static void trimLocked(const Options& opt, int reserve) {
+    while (!g_transcript.empty() &&
+           (g_transcript.size() > static_cast<size_t>(opt.maxTurns) ||
+            g_transcriptTokens + reserve > opt.maxTokens)) {
+        g_transcriptTokens -= g_transcript.front().tokens;
+        g_transcript.pop_front();
+        g_stats.trimmedTurns++;
+    }
+}
+
+static std::string renderLocked(const std::string& prompt) {
+    if (g_transcript.empty()) return prompt;
+
+    std::string out = "The conversation so far:\n";
+    for (const auto& m : g_transcript) {
+        out += (m.role == "user" ? "User: " : "Assistant: ") + m.text + "\n";
+    }
+    out += "\nCurrent message: " + prompt;
+    return out;
+}
+
+// ============================================================
+// Request builders
+// ============================================================
+nlohmann::json ollamaBody(const std::string& model, const std::string& prompt, bool stream) {
+    nlohmann::json body = {{"model", model}, {"stream", stream}};
+    Options opt = loadOptions();
+    if (!opt.enabled) {
+        body["prompt"] = prompt;
+        return body;
+    }
+
+    int promptTokens = estimateTokens(prompt);
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    // The server already holds the history: send only what is new
+    if (opt.reuseKv && g_contextValid && g_contextModel == model &&
+        static_cast<int>(g_context.size()) + promptTokens <= opt.maxTokens) {
+        body["prompt"]  = prompt;
+        body["context"] = g_context;
+        g_stats.kvReused++;
+        return body;
+    }
+
+    trimLocked(opt, promptTokens);
+    if (!g_transcript.empty()) g_stats.rebuilds++;
+    body["prompt"] = renderLocked(prompt);
+    return body;
+}
+
+nlohmann::json chatMessages(const std::string& prompt) {
+    nlohmann::json messages = nlohmann::json::array();
+    Options opt = loadOptions();
+    if (opt.enabled) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        trimLocked(opt, estimateTokens(prompt));
+        for (const auto& m : g_transcript) {
+            messages.push_back({{"role", m.role}, {"content", m.text}});
+        }
+    }
+    messages.push_back({{"role", "user"}, {"content", prompt}});
+    return messages;
+}
+
+// ============================================================
+// Recording
+// ============================================================
+void record(const std::string& prompt, const std::string& reply,
+            const std::string& model, const nlohmann::json& ollamaFinal) {
+    Options opt = loadOptions();
+    if (!opt.enabled || reply.empty()) return;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    auto append = [](const char* role, const std::string& text) {
+        Message m{role, text, estimateTokens(text)};
+        g_transcriptTokens += m.tokens;
+        g_transcript.push_back(std::move(m));
+    };
+    append("user", prompt);
+    append("assistant", reply);
+    trimLocked(opt, 0);
+    g_stats.exchanges++;
+
+    // Context must cover every recorded turn; otherwise rebuild next time
+    bool haveContext = opt.reuseKv && ollamaFinal.is_object() &&
+                       ollamaFinal.contains("context") && ollamaFinal["context"].is_array() &&
+                       !ollamaFinal["context"].empty();
+    if (haveContext) {
+        g_context      = ollamaFinal["context"];
+        g_contextModel = model;
+        g_contextValid = true;
+    } else {
+        g_context      = nlohmann::json::array();
+        g_contextValid = false;
+    }
+
+    if (ollamaFinal.is_object() && ollamaFinal.contains("prompt_eval_count")) {
+        g_stats.promptEvalCount += ollamaFinal.value("prompt_eval_count", 0ULL);
+        g_stats.promptEvalMs    += ollamaFinal.value("prompt_eval_duration", 0.0) / 1e6;   // ns
+        g_stats.promptEvalTurns++;
+    }
+}
+
+bool hasContext() {
+    if (!loadOptions().enabled) return false;
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return !g_transcript.empty();
+}
+
+void reset() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_transcript.clear();
+    g_transcriptTokens = 0;
+    g_context      = nlohmann::json::array();
+    g_contextValid = false;
+    g_contextModel.clear();
+    g_stats = Stats{};
+    LOG_DEBUG("AI", "Conversation reset");
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Stats s = g_stats;
+    s.turns            = g_transcript.size();
+    s.transcriptTokens = g_transcriptTokens;
+    s.contextTokens    = g_contextValid ? g_context.size() : 0;
+    return s;
+}
+
+} // namespace Conversation
@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+// ============================================================
+// Conversation — multi-turn context for AI requests
+// ============================================================
+// - Keeps a rolling transcript of user / assistant turns, trimmed
+//   oldest-first to a token budget (estimated, ~4 chars a token).
+// - Ollama: the "context" array from the last reply is sent back
+//   with only the new prompt, so the server reuses its KV cache
+//   instead of re-reading the history. When there is no usable
+//   context (first turn, other model, over budget, a turn it did
+//   not see) the trimmed transcript is sent once as text.
+// - Chat backends (LocalAI / OpenAI) get the trimmed transcript
+//   as a messages array.
+// - Tuned by ai_config.json "conversation".
+// ============================================================
+namespace Conversation {
+    struct Options {
+        bool enabled   = true;
+        int  maxTokens = 2048;   // transcript / KV context budget
+        int  maxTurns  = 20;     // user + assistant messages kept
+        bool reuseKv   = true;   // send Ollama's context array back
+    };
+    Options loadOptions();
+
+    int estimateTokens(const std::string& text);
+
+    // Request body for Ollama /api/generate
+    nlohmann::json ollamaBody(const std::string& model, const std::string& prompt, bool stream);
+
+    // "messages" array for /chat/completions, ending with prompt
+    nlohmann::json chatMessages(const std::string& prompt);
+
+    // A completed exchange. ollamaFinal is Ollama's last reply object
+    // (with "context" and prompt_eval_* fields), null for other backends.
+    void record(const std::string& prompt, const std::string& reply,
+                const std::string& model,
+                const nlohmann::json& ollamaFinal = nullptr);
+
+    // Earlier turns would be sent with the next prompt
+    bool hasContext();
+
+    void reset();
+
+    struct Stats {
+        uint64_t exchanges       = 0;
+        uint64_t kvReused        = 0;   // Ollama turns sent with context
+        uint64_t rebuilds        = 0;   // transcript sent as text instead
+        uint64_t trimmedTurns    = 0;
+        uint64_t promptEvalCount = 0;   // tokens Ollama actually evaluated
+        double   promptEvalMs    = 0.0;
+        uint64_t promptEvalTurns = 0;
+        size_t   turns           = 0;
+        int      transcriptTokens = 0;
+        size_t   contextTokens   = 0;   // length of the held KV context
+    };
+    Stats getStats();
+}
@@ -0,0 +1,218 @@
+#include "ai_executor.hpp"
+#include "ai.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AIExecutor {
+
+using Clock = std::chrono::steady_clock;
+
+struct Task {
+    Job                        job;
+    Context                    ctx;
+    std::promise<std::string>  promise;
+    Clock::time_point          queuedAt;
+};
+
+// ---------------- State ----------------
+static std::mutex               g_mutex;
+static std::condition_variable  g_cv;
+static std::array<std::deque<Task>, 3> g_queues;   // indexed by Priority
+static std::vector<std::thread> g_workers;
+static bool                     g_stopping = false;
+static Options                  g_options;   // snapshot taken by init()
+static Stats                    g_stats;
+
+// ============================================================
+// Context
+// ============================================================
+bool Context::expired() const {
+    return hasDeadline && Clock::now() >= deadline;
+}
+
+int Context::remainingMs() const {
+    if (!hasDeadline) return 0;
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    return static_cast<int>(std::max<long long>(1, left));
+}
+
+bool isAborted(const std::string& reply) {
+    return reply == REPLY_CANCELLED || reply == REPLY_EXPIRED || reply == REPLY_DROPPED;
+}
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("executor")) {
+        const auto& e = aiConfig["executor"];
+        opt.workers   = e.value("workers", opt.workers);
+        opt.queueSize = e.value("queue_size", opt.queueSize);
+    }
+    opt.workers   = std::clamp(opt.workers, 1, 16);
+    opt.queueSize = std::max(1, opt.queueSize);
+    return opt;
+}
+
+// ============================================================
+// Workers
+// ============================================================
+static size_t queuedLocked() {
+    size_t n = 0;
+    for (const auto& q : g_queues) n += q.size();
+    return n;
+}
+
+static void workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(g_mutex);
+            g_cv.wait(lock, [] { return g_stopping || queuedLocked() > 0; });
+            if (g_stopping) return;
+
+            // Highest priority first, oldest first within it
+            for (auto& q : g_queues) {
+                if (!q.empty()) {
+                    task = std::move(q.front());
+                    q.pop_front();
+                    break;
+                }
+            }
+            g_stats.waitMs += std::chrono::duration<double, std::milli>(
+                                  Clock::now() - task.queuedAt).count();
+
+            // Skip work nobody is waiting for any more
+            if (task.ctx.token.cancelled()) {
+                g_stats.cancelled++;
+                task.promise.set_value(REPLY_CANCELLED);
+                continue;
+            }
+            if (task.ctx.expired()) {
+                g_stats.expired++;
+                task.promise.set_value(REPLY_EXPIRED);
+                continue;
+            }
+            g_stats.active++;
+        }
+
+        try {
+            task.promise.set_value(task.job(task.ctx));
+        } catch (...) {
+            task.promise.set_exception(std::current_exception());
+        }
+
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_stats.active--;
+        g_stats.completed++;
+    }
+}
+
+// Caller holds g_mutex. The first submit may come from any thread,
+// so this uses the options init() took, not aiConfig.
+static void startWorkersLocked() {
+    if (!g_workers.empty()) return;
+    g_stopping = false;
+    for (int i = 0; i < g_options.workers; i++) g_workers.emplace_back(workerLoop);
+    g_stats.workers = g_options.workers;
+    LOG_DEBUG("AI", "Executor started: " + std::to_string(g_options.workers) +
+                    " workers, queue " + std::to_string(g_options.queueSize));
+}
+
+// ============================================================
+// Public API
+// ============================================================
+void init() {
+    Options opt = loadOptions();
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_options = opt;
+}
+
+std::future<std::string> submit(Job job, const Request& request) {
+    Task task;
+    task.job       = std::move(job);
+    task.ctx.token = request.token;
+    task.queuedAt  = Clock::now();
+    if (request.deadlineMs > 0) {
+        task.ctx.hasDeadline = true;
+        task.ctx.deadline    = task.queuedAt + std::chrono::milliseconds(request.deadlineMs);
+    }
+    auto future = task.promise.get_future();
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_stats.submitted++;
+    if (g_stopping) {
+        g_stats.cancelled++;
+        task.promise.set_value(REPLY_CANCELLED);
+        return future;
+    }
+    startWorkersLocked();
+
+    size_t prio = static_cast<size_t>(request.priority);
+    if (queuedLocked() >= static_cast<size_t>(g_options.queueSize)) {
+        // Make room by evicting the newest request of a lower priority
+        bool evicted = false;
+        for (size_t p = g_queues.size() - 1; p > prio; p--) {
+            if (g_queues[p].empty()) continue;
+            g_queues[p].back().promise.set_value(REPLY_DROPPED);
+            g_queues[p].pop_back();
+            evicted = true;
+            break;
+        }
+        g_stats.dropped++;
+        if (!evicted) {
+            LOG_DEBUG("AI", "Executor queue full, refusing request");
+            task.promise.set_value(REPLY_DROPPED);
+            return future;
+        }
+    }
+
+    g_queues[prio].push_back(std::move(task));
+    g_stats.maxQueued = std::max(g_stats.maxQueued, queuedLocked());
+    g_cv.notify_one();
+    return future;
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Stats s  = g_stats;
+    s.queued = queuedLocked();
+    return s;
+}
+
+void resetStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    int active  = g_stats.active;
+    int workers = g_stats.workers;
+    g_stats = Stats{};
+    g_stats.active  = active;
+    g_stats.workers = workers;
+}
+
+void shutdown() {
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_stopping = true;
+        for (auto& q : g_queues) {
+            for (auto& task : q) task.promise.set_value(REPLY_CANCELLED);
+            g_stats.cancelled += q.size();
+            q.clear();
+        }
+        workers.swap(g_workers);
+    }
+    g_cv.notify_all();
+
+    // Running jobs finish their current request (bounded by its timeout)
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+}
+
+} // namespace AIExecutor
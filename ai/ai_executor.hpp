@@ -0,0 +1,100 @@
+#pragma once
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+
+// ============================================================
+// AIExecutor — bounded worker pool for AI backend requests
+// ============================================================
+// - A fixed number of workers (ai_config.json "executor.workers")
+//   run every AI request, so a burst queues instead of opening
+//   one thread and one model-server connection per call.
+// - The queue is bounded. When full, a new request evicts the
+//   newest queued request of a lower priority, or is refused.
+// - Interactive (voice / typed) requests are dequeued before
+//   Normal, Normal before Background; FIFO within a priority.
+// - Cancelled or expired requests resolve without running; a
+//   running job sees both through its Context.
+// ============================================================
+namespace AIExecutor {
+    enum class Priority { Interactive = 0, Normal = 1, Background = 2 };
+
+    // Copies share one flag, so a caller can keep a token and
+    // cancel the request it handed the same token to.
+    class CancelToken {
+    public:
+        CancelToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+        void cancel() const { flag_->store(true); }
+        bool cancelled() const { return flag_->load(); }
+        bool operator==(const CancelToken& other) const { return flag_ == other.flag_; }
+    private:
+        std::shared_ptr<std::atomic<bool>> flag_;
+    };
+
+    struct Request {
+        Priority    priority   = Priority::Normal;
+        CancelToken token;
+        int         deadlineMs = 0;   // from submit; 0 = none
+
+        Request(Priority p = Priority::Normal, CancelToken t = CancelToken{}, int deadline = 0)
+            : priority(p), token(std::move(t)), deadlineMs(deadline) {}
+    };
+
+    // What a running job can see of its request
+    struct Context {
+        CancelToken token;
+        std::chrono::steady_clock::time_point deadline{};
+        bool hasDeadline = false;
+
+        bool expired() const;
+        bool stopRequested() const { return token.cancelled() || expired(); }
+        // Milliseconds left before the deadline (0 = no deadline)
+        int remainingMs() const;
+    };
+
+    using Job = std::function<std::string(const Context&)>;
+
+    // Replies for requests that never reached (or left) the backend
+    inline constexpr const char* REPLY_CANCELLED = "[AI] Request cancelled";
+    inline constexpr const char* REPLY_EXPIRED   = "[AI] Request deadline exceeded";
+    inline constexpr const char* REPLY_DROPPED   = "[AI] Request dropped (queue full)";
+
+    // True for the three replies above; callers should not retry these
+    bool isAborted(const std::string& reply);
+
+    // Exceptions thrown by the job are rethrown by future.get()
+    std::future<std::string> submit(Job job, const Request& request = Request{});
+
+    struct Options {
+        int workers   = 2;
+        int queueSize = 16;
+    };
+    Options loadOptions();
+
+    // Snapshot the options from aiConfig. Call on the main thread once
+    // the config is loaded; workers start with whatever was snapshot
+    // (defaults if init never ran), never reading aiConfig themselves.
+    void init();
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t cancelled = 0;
+        uint64_t expired   = 0;
+        uint64_t dropped   = 0;   // refused or evicted by a full queue
+        double   waitMs    = 0.0; // total time spent queued
+        size_t   maxQueued = 0;
+        size_t   queued    = 0;
+        int      active    = 0;
+        int      workers   = 0;
+    };
+    Stats getStats();
+    void  resetStats();
+
+    // Resolve everything still queued as cancelled and join workers
+    void shutdown();
+}
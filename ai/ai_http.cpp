@@ -0,0 +1,169 @@
+#include "ai_http.hpp"
+#include "ai.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace HttpPool {
+
+// ---------------- State ----------------
+static std::mutex g_poolMutex;
+static std::unordered_map<std::string, std::vector<std::unique_ptr<cpr::Session>>> g_idle;
+static Stats g_stats;
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("http")) {
+        const auto& h = aiConfig["http"];
+        opt.connectTimeoutMs = h.value("connect_timeout_ms", opt.connectTimeoutMs);
+        opt.timeoutMs        = h.value("timeout_ms", opt.timeoutMs);
+        opt.keepAlive        = h.value("keep_alive", opt.keepAlive);
+        opt.maxIdlePerHost   = h.value("max_idle_per_host", opt.maxIdlePerHost);
+    }
+    opt.maxIdlePerHost = std::max(0, opt.maxIdlePerHost);
+    return opt;
+}
+
+// "http://127.0.0.1:11434/api/generate" → "http://127.0.0.1:11434"
+static std::string originOf(const std::string& url) {
+    size_t scheme = url.find("://");
+    size_t start  = (scheme == std::string::npos) ? 0 : scheme + 3;
+    size_t slash  = url.find('/', start);
+    return slash == std::string::npos ? url : url.substr(0, slash);
+}
+
+// ============================================================
+// Checkout / return
+// ============================================================
+static std::unique_ptr<cpr::Session> acquire(const std::string& key, bool reuse) {
+    {
+        std::lock_guard<std::mutex> lock(g_poolMutex);
+        g_stats.requests++;
+        auto it = g_idle.find(key);
+        if (reuse && it != g_idle.end() && !it->second.empty()) {
+            auto session = std::move(it->second.back());
+            it->second.pop_back();
+            g_stats.reused++;
+            return session;
+        }
+        g_stats.created++;
+    }
+    return std::make_unique<cpr::Session>();
+}
+
+static void release(const std::string& key, std::unique_ptr<cpr::Session> session,
+                    bool healthy, bool reuse, int maxIdle) {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    if (!healthy) {
+        g_stats.discarded++;
+        return;
+    }
+    if (!reuse) return;
+
+    auto& idle = g_idle[key];
+    if (static_cast<int>(idle.size()) < maxIdle) idle.push_back(std::move(session));
+}
+
+static cpr::Response postWith(const std::string& url, const cpr::Header& headers,
+                              const std::string& body, int timeoutMs,
+                              const cpr::WriteCallback* writeCallback,
+                              const CancelFn& cancelled, bool reuse) {
+    Options opt = loadOptions();
+    std::string key = originOf(url) + (writeCallback ? "#stream" : "");
+
+    auto session = acquire(key, reuse);
+    session->SetUrl(cpr::Url{url});
+    session->SetHeader(headers);
+    session->SetBody(cpr::Body{body});
+    session->SetConnectTimeout(cpr::ConnectTimeout{opt.connectTimeoutMs});
+    session->SetTimeout(cpr::Timeout{timeoutMs > 0 ? timeoutMs : opt.timeoutMs});
+    if (writeCallback) session->SetWriteCallback(*writeCallback);
+
+    // Always set: a pooled session must not keep a previous caller's check.
+    // curl calls this while waiting for the first byte too, so a request
+    // can be abandoned before the backend has produced anything.
+    session->SetProgressCallback(cpr::ProgressCallback{
+        [cancelled](auto, auto, auto, auto, intptr_t) -> bool {
+            return !(cancelled && cancelled());
+        }});
+
+    cpr::Response resp = session->Post();
+    release(key, std::move(session), !resp.error, reuse, opt.maxIdlePerHost);
+    return resp;
+}
+
+// ============================================================
+// Public API
+// ============================================================
+cpr::Response post(const std::string& url,
+                   const cpr::Header& headers,
+                   const std::string& body,
+                   int timeoutMs,
+                   const cpr::WriteCallback* writeCallback,
+                   const CancelFn& cancelled) {
+    return postWith(url, headers, body, timeoutMs, writeCallback, cancelled, loadOptions().keepAlive);
+}
+
+cpr::Response get(const std::string& url, int timeoutMs) {
+    Options opt = loadOptions();
+    std::string key = originOf(url);
+
+    auto session = acquire(key, opt.keepAlive);
+    session->SetUrl(cpr::Url{url});
+    int connectMs = timeoutMs > 0 ? std::min(opt.connectTimeoutMs, timeoutMs) : opt.connectTimeoutMs;
+    session->SetConnectTimeout(cpr::ConnectTimeout{connectMs});
+    session->SetTimeout(cpr::Timeout{timeoutMs > 0 ? timeoutMs : opt.timeoutMs});
+
+    cpr::Response resp = session->Get();
+    release(key, std::move(session), !resp.error, opt.keepAlive, opt.maxIdlePerHost);
+    return resp;
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    Stats s = g_stats;
+    s.idle = 0;
+    for (const auto& [_, sessions] : g_idle) s.idle += sessions.size();
+    return s;
+}
+
+void resetStats() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    g_stats = Stats{};
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    g_idle.clear();
+}
+
+// ============================================================
+// Bench
+// ============================================================
+std::vector<double> bench(const std::string& url, const std::string& body,
+                          int requests, bool reuse) {
+    std::vector<double> latencies;
+    if (reuse) clear();   // first request pays the connect, like a cold start
+
+    cpr::Header headers{{"Content-Type", "application/json"}};
+    for (int i = 0; i < requests; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        cpr::Response resp = postWith(url, headers, body, 0, nullptr, nullptr, reuse);
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - t0).count();
+        if (resp.status_code != 200) {
+            LOG_ERROR("AI", "HTTP bench request failed: " + resp.error.message);
+            return {};
+        }
+        latencies.push_back(ms);
+    }
+    return latencies;
+}
+
+} // namespace HttpPool
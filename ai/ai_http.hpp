@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <cpr/cpr.h>
+
+// ============================================================
+// HttpPool — shared keep-alive sessions for AI backends
+// ============================================================
+// - Idle cpr::Sessions are pooled per origin (scheme://host:port);
+//   each keeps its curl handle and therefore its open connection,
+//   so repeat requests skip TCP/TLS setup.
+// - Streaming and buffered requests use separate sessions: a
+//   session that once had a write callback keeps it.
+// - A session that errored is dropped instead of returned.
+// - Timeouts and keep-alive come from ai_config.json "http".
+// ============================================================
+namespace HttpPool {
+    struct Options {
+        int  connectTimeoutMs = 2000;
+        int  timeoutMs        = 60000;
+        bool keepAlive        = true;    // false = fresh session per request
+        int  maxIdlePerHost   = 4;
+    };
+    Options loadOptions();
+
+    // Polled while the transfer runs; returning true aborts it
+    using CancelFn = std::function<bool()>;
+
+    // timeoutMs <= 0 uses the configured request timeout.
+    // With a write callback the body goes there, not to resp.text.
+    // An aborted request comes back with resp.error set.
+    cpr::Response post(const std::string& url,
+                       const cpr::Header& headers,
+                       const std::string& body,
+                       int timeoutMs = 0,
+                       const cpr::WriteCallback* writeCallback = nullptr,
+                       const CancelFn& cancelled = nullptr);
+
+    cpr::Response get(const std::string& url, int timeoutMs = 0);
+
+    struct Stats {
+        uint64_t requests  = 0;
+        uint64_t reused    = 0;   // served by an idle pooled session
+        uint64_t created   = 0;
+        uint64_t discarded = 0;   // dropped after a transport error
+        size_t   idle      = 0;
+    };
+    Stats getStats();
+    void  resetStats();
+
+    // Drop every idle session (closes their connections)
+    void clear();
+
+    // Sequential POSTs to url, with pooled sessions or a new one each
+    // time. Returns per-request latencies in ms (empty on failure).
+    std::vector<double> bench(const std::string& url, const std::string& body,
+                              int requests, bool reuse);
+}
@@ -0,0 +1,307 @@
+#include "ai_mock_server.hpp"
+#include "logger.hpp"
+
+#include <SFML/Network.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MockLLM {
+
+// ---------------- State ----------------
+static std::mutex          g_serverMutex;
+static std::thread         g_acceptThread;
+static std::atomic<bool>   g_running{false};
+static std::atomic<int>    g_activeConnections{0};
+static unsigned short      g_port = 0;
+static Options             g_options;
+static Stats               g_stats;   // guarded by g_serverMutex
+static uint64_t            g_generateCount = 0;
+
+// Canned reply, cycled to the requested token count
+static const std::vector<std::string> kWords = {
+    "Sure", ",", " here", " is", " a", " short", " answer", ".",
+    " It", " streams", " one", " token", " at", " a", " time", "."
+};
+
+// ============================================================
+// HTTP helpers
+// ============================================================
+static bool sendAll(sf::TcpSocket& socket, const std::string& data) {
+    return socket.send(data.data(), data.size()) == sf::Socket::Status::Done;
+}
+
+// Read headers + Content-Length body. Returns false on disconnect.
+static bool readRequest(sf::TcpSocket& socket, std::string& method,
+                        std::string& path, std::string& body, bool& keepAlive) {
+    std::string raw;
+    char buf[4096];
+    size_t headerEnd = std::string::npos;
+
+    while (headerEnd == std::string::npos) {
+        size_t received = 0;
+        if (socket.receive(buf, sizeof(buf), received) != sf::Socket::Status::Done) return false;
+        raw.append(buf, received);
+        headerEnd = raw.find("\r\n\r\n");
+    }
+
+    std::string head = raw.substr(0, headerEnd);
+    size_t sp1 = head.find(' ');
+    size_t sp2 = head.find(' ', sp1 + 1);
+    if (sp1 == std::string::npos || sp2 == std::string::npos) return false;
+    method = head.substr(0, sp1);
+    path   = head.substr(sp1 + 1, sp2 - sp1 - 1);
+
+    size_t contentLength = 0;
+    std::string lower = head;
+    for (auto& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    size_t cl = lower.find("content-length:");
+    if (cl != std::string::npos) {
+        contentLength = std::stoul(head.substr(cl + 15));
+    }
+
+    // HTTP/1.1 defaults to persistent connections
+    keepAlive = lower.find("connection: close") == std::string::npos;
+
+    body = raw.substr(headerEnd + 4);
+    while (body.size() < contentLength) {
+        size_t received = 0;
+        if (socket.receive(buf, sizeof(buf), received) != sf::Socket::Status::Done) return false;
+        body.append(buf, received);
+    }
+    return true;
+}
+
+static bool sendJson(sf::TcpSocket& socket, int status, const nlohmann::json& j) {
+    std::string payload = j.dump();
+    return sendAll(socket, "HTTP/1.1 " + std::to_string(status) + (status == 200 ? " OK" : " Error") +
+                           "\r\nContent-Type: application/json\r\nContent-Length: " +
+                           std::to_string(payload.size()) + "\r\n\r\n" + payload);
+}
+
+// One chunk of a Transfer-Encoding: chunked body
+static bool sendChunk(sf::TcpSocket& socket, const std::string& data) {
+    char size[16];
+    std::snprintf(size, sizeof(size), "%zx\r\n", data.size());
+    return sendAll(socket, size + data + "\r\n");
+}
+
+// ============================================================
+// Generation
+// ============================================================
+static std::string tokenAt(int i) {
+    return kWords[static_cast<size_t>(i) % kWords.size()];
+}
+
+static void recordGeneration(std::chrono::steady_clock::time_point start, int tokens, bool aborted) {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    g_stats.requests++;
+    g_stats.tokens += static_cast<uint64_t>(tokens);
+    if (aborted) g_stats.aborted++;
+    g_stats.generationMs += std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start).count();
+}
+
+// Bresenham-style: the n-th request fails when floor(n * rate) steps up
+static bool shouldFail(const Options& opt) {
+    if (opt.failRate <= 0.0) return false;
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    uint64_t n = ++g_generateCount;
+    double rate = std::min(1.0, opt.failRate);
+    bool fail = static_cast<uint64_t>(n * rate) != static_cast<uint64_t>((n - 1) * rate);
+    if (fail) {
+        g_stats.requests++;
+        g_stats.failures++;
+    }
+    return fail;
+}
+
+static bool streamReply(sf::TcpSocket& socket, bool sse, const std::string& model,
+                        const Options& opt) {
+    // Chunked, so the connection stays usable for the next request
+    if (!sendAll(socket, std::string("HTTP/1.1 200 OK\r\nContent-Type: ") +
+                         (sse ? "text/event-stream" : "application/x-ndjson") +
+                         "\r\nTransfer-Encoding: chunked\r\n\r\n")) return false;
+
+    // Like a real server, generation stops when a write fails
+    auto start = std::chrono::steady_clock::now();
+    int produced = 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.firstTokenMs));
+    for (int i = 0; i < opt.tokens && g_running; i++) {
+        if (i > 0) std::this_thread::sleep_for(std::chrono::milliseconds(opt.tokenMs));
+
+        std::string line;
+        if (sse) {
+            nlohmann::json chunk = {
+                {"model", model},
+                {"choices", {{{"index", 0}, {"delta", {{"content", tokenAt(i)}}}}}}
+            };
+            line = "data: " + chunk.dump() + "\n\n";
+        } else {
+            line = nlohmann::json{{"model", model}, {"response", tokenAt(i)}, {"done", false}}.dump() + "\n";
+        }
+        produced++;
+        if (!sendChunk(socket, line)) {
+            recordGeneration(start, produced, true);
+            return false;
+        }
+    }
+    recordGeneration(start, produced, false);
+
+    std::string last = sse ? std::string("data: [DONE]\n\n")
+                           : nlohmann::json{{"model", model}, {"response", ""}, {"done", true},
+                                            {"context", nlohmann::json::array()}}.dump() + "\n";
+    return sendChunk(socket, last) && sendAll(socket, "0\r\n\r\n");
+}
+
+static std::string fullReply(const Options& opt) {
+    std::string text;
+    for (int i = 0; i < opt.tokens; i++) text += tokenAt(i);
+    return text;
+}
+
+static void handleConnection(std::unique_ptr<sf::TcpSocket> socket) {
+    // Serve requests until the client closes or asks to
+    std::string method, path, body;
+    bool keepAlive = true;
+    while (keepAlive && g_running && readRequest(*socket, method, path, body, keepAlive)) {
+        Options opt = options();
+        auto req = nlohmann::json::parse(body.empty() ? "{}" : body, nullptr, false);
+        if (req.is_discarded()) req = nlohmann::json::object();
+        bool stream = req.value("stream", false);
+        std::string model = req.value("model", "mock");
+        bool generate = method == "POST" && (path == "/api/generate" ||
+                                             path.find("/chat/completions") != std::string::npos);
+        bool sent = false;
+
+        if (method == "GET" && (path == "/api/tags" || path.find("/models") != std::string::npos)) {
+            sent = sendJson(*socket, 200, {{"models", nlohmann::json::array({{{"name", "mock"}}})}});
+        } else if (generate && shouldFail(opt)) {
+            sent = sendJson(*socket, opt.failStatus, {{"error", "mock failure"}});
+        } else if (method == "POST" && path == "/api/generate") {
+            if (stream) {
+                sent = streamReply(*socket, false, model, opt);
+            } else {
+                auto start = std::chrono::steady_clock::now();
+                std::this_thread::sleep_for(std::chrono::milliseconds(
+                    opt.firstTokenMs + opt.tokenMs * std::max(0, opt.tokens - 1)));
+                recordGeneration(start, opt.tokens, false);
+                sent = sendJson(*socket, 200, {{"model", model}, {"response", fullReply(opt)}, {"done", true}});
+            }
+        } else if (method == "POST" && path.find("/chat/completions") != std::string::npos) {
+            if (stream) {
+                sent = streamReply(*socket, true, model, opt);
+            } else {
+                auto start = std::chrono::steady_clock::now();
+                std::this_thread::sleep_for(std::chrono::milliseconds(
+                    opt.firstTokenMs + opt.tokenMs * std::max(0, opt.tokens - 1)));
+                recordGeneration(start, opt.tokens, false);
+                sent = sendJson(*socket, 200, {
+                    {"model", model},
+                    {"choices", {{{"index", 0},
+                                  {"message", {{"role", "assistant"}, {"content", fullReply(opt)}}}}}}
+                });
+            }
+        } else {
+            sent = sendJson(*socket, 404, {{"error", "not found: " + path}});
+        }
+        if (!sent) break;
+    }
+
+    socket->disconnect();
+    g_activeConnections--;
+}
+
+static void acceptLoop(std::shared_ptr<sf::TcpListener> listener) {
+    while (g_running) {
+        auto socket = std::make_unique<sf::TcpSocket>();
+        if (listener->accept(*socket) != sf::Socket::Status::Done) {
+            // Non-blocking listener: nothing pending
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        socket->setBlocking(true);
+        g_activeConnections++;
+        std::thread(handleConnection, std::move(socket)).detach();
+    }
+    listener->close();
+}
+
+// ============================================================
+// Control API
+// ============================================================
+bool start(const Options& options, unsigned short port) {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    if (g_running) return false;
+
+    auto listener = std::make_shared<sf::TcpListener>();
+    if (listener->listen(port, sf::IpAddress::LocalHost) != sf::Socket::Status::Done) {
+        LOG_ERROR("MockLLM", "Could not listen on port " + std::to_string(port));
+        return false;
+    }
+    listener->setBlocking(false);
+
+    g_options = options;
+    g_generateCount = 0;
+    g_port    = listener->getLocalPort();
+    g_running = true;
+    g_acceptThread = std::thread(acceptLoop, listener);
+
+    LOG_DEBUG("MockLLM", "Listening on " + baseUrl());
+    return true;
+}
+
+void stop() {
+    {
+        std::lock_guard<std::mutex> lock(g_serverMutex);
+        if (!g_running) return;
+        g_running = false;
+    }
+    if (g_acceptThread.joinable()) g_acceptThread.join();
+
+    // Streaming handlers notice g_running between tokens
+    for (int i = 0; i < 200 && g_activeConnections > 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    LOG_DEBUG("MockLLM", "Stopped");
+}
+
+bool running() {
+    return g_running;
+}
+
+void setOptions(const Options& options) {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    g_options = options;
+    g_generateCount = 0;
+}
+
+Options options() {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    return g_options;
+}
+
+unsigned short port() {
+    return g_port;
+}
+
+std::string baseUrl() {
+    return "http://127.0.0.1:" + std::to_string(g_port);
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    return g_stats;
+}
+
+void resetStats() {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    g_stats = Stats{};
+}
+
+} // namespace MockLLM
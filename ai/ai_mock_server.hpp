@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// ============================================================
+// MockLLM — local stand-in for an AI backend
+// ============================================================
+// Speaks just enough HTTP/1.1 for the AI client paths:
+//   POST /api/generate         Ollama (NDJSON when "stream": true)
+//   POST /v1/chat/completions  OpenAI-compatible (SSE when streaming)
+//   GET  /api/tags, /v1/models health probes
+// Tokens are emitted with a configurable first-token delay and
+// per-token interval so streaming latency can be measured offline.
+// A share of generate / chat requests can be made to fail, spread
+// evenly (every 4th at 0.25) so runs are repeatable.
+// Connections are kept alive (streams use chunked encoding) so
+// client-side connection reuse shows up in measurements.
+// ============================================================
+namespace MockLLM {
+    struct Options {
+        int firstTokenMs = 300;   // delay before the first token
+        int tokenMs      = 30;    // interval between tokens
+        int tokens       = 40;    // tokens per reply
+        double failRate  = 0.0;   // share of requests answered with failStatus
+        int failStatus   = 500;
+    };
+
+    // Listen on 127.0.0.1:port (0 = any free port). Returns false if
+    // the port could not be bound or the server is already running.
+    bool start(const Options& options = Options{}, unsigned short port = 0);
+    void stop();
+    bool running();
+
+    // Applies from the next request, also on kept-alive connections
+    void    setOptions(const Options& options);
+    Options options();
+
+    unsigned short port();
+    std::string baseUrl();   // "http://127.0.0.1:<port>"
+
+    // Server-side view of generation work, including replies nobody
+    // read to the end (a closed connection stops generation)
+    struct Stats {
+        uint64_t requests     = 0;   // generate / chat requests
+        uint64_t tokens       = 0;   // tokens produced
+        uint64_t aborted      = 0;   // client went away mid-reply
+        uint64_t failures     = 0;   // answered with failStatus
+        double   generationMs = 0.0; // time spent generating
+    };
+    Stats getStats();
+    void  resetStats();
+}
@@ -0,0 +1,367 @@
+#include "ai_response_cache.hpp"
+#include "ai.hpp"
+#include "ai_executor.hpp"
+#include "resources.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace ResponseCache {
+
+// ---------------- State ----------------
+struct Node {
+    std::string key;
+    std::string prompt;        // normalized
+    std::string model;
+    std::string backend;
+    std::string reply;
+    long long   created      = 0;    // unix seconds
+    double      generationMs = 0.0;
+    std::vector<size_t> grams;       // sorted trigram hashes (not persisted)
+};
+
+static std::mutex g_cacheMutex;
+static std::list<Node> g_lru;   // front = most recently used
+static std::unordered_map<std::string, std::list<Node>::iterator> g_index;
+static bool    g_loaded = false;
+static Options g_opt;   // snapshot taken by init()
+static Stats   g_stats;
+
+// Saved off the reply path: a background job at most every
+// SAVE_INTERVAL while dirty, and save() at shutdown
+static constexpr auto SAVE_INTERVAL = std::chrono::seconds(60);
+static bool       g_dirty = false;
+static std::chrono::steady_clock::time_point g_lastSave = std::chrono::steady_clock::now();
+static std::mutex g_saveMutex;   // one writer of the file at a time
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("response_cache")) {
+        const auto& c = aiConfig["response_cache"];
+        opt.enabled       = c.value("enabled", opt.enabled);
+        opt.capacity      = c.value("capacity", opt.capacity);
+        opt.ttlSeconds    = c.value("ttl_s", opt.ttlSeconds);
+        opt.fuzzy         = c.value("fuzzy", opt.fuzzy);
+        opt.minSimilarity = c.value("min_similarity", opt.minSimilarity);
+        opt.path          = c.value("path", opt.path);
+    }
+    opt.capacity = std::max(1, opt.capacity);
+    fs::path path(opt.path);
+    if (path.is_relative()) opt.path = (fs::path(getResourcePath()) / path).string();
+    return opt;
+}
+
+void init() {
+    Options opt = loadOptions();
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_opt = opt;
+}
+
+Options options() {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    return g_opt;
+}
+
+static long long nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// ============================================================
+// Normalization / similarity
+// ============================================================
+static std::string normalize(const std::string& prompt) {
+    std::string out;
+    out.reserve(prompt.size());
+    bool space = false;
+    for (unsigned char c : prompt) {
+        if (std::isspace(c)) {
+            space = !out.empty();
+            continue;
+        }
+        if (space) out += ' ';
+        space = false;
+        out += static_cast<char>(std::tolower(c));
+    }
+    while (!out.empty() && std::ispunct(static_cast<unsigned char>(out.back()))) out.pop_back();
+    return out;
+}
+
+static std::string makeKey(const std::string& prompt, const std::string& model,
+                           const std::string& backend) {
+    return backend + '\n' + model + '\n' + prompt;
+}
+
+static std::vector<size_t> trigrams(const std::string& text) {
+    std::vector<size_t> grams;
+    std::string padded = " " + text + " ";
+    std::hash<std::string_view> hash;
+    for (size_t i = 0; i + 3 <= padded.size(); i++) {
+        grams.push_back(hash(std::string_view(padded).substr(i, 3)));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// Dice coefficient of two sorted, unique sets
+static double similarity(const std::vector<size_t>& a, const std::vector<size_t>& b) {
+    if (a.empty() || b.empty()) return 0.0;
+    size_t common = 0;
+    for (size_t i = 0, j = 0; i < a.size() && j < b.size();) {
+        if (a[i] == b[j])     { common++; i++; j++; }
+        else if (a[i] < b[j]) i++;
+        else                  j++;
+    }
+    return 2.0 * common / (a.size() + b.size());
+}
+
+// "what is 12 times 7" must not answer "what is 12 times 8"
+static std::string digitsOf(const std::string& text) {
+    std::string d;
+    for (char c : text) {
+        if (std::isdigit(static_cast<unsigned char>(c))) d += c;
+        else if (!d.empty() && d.back() != ' ') d += ' ';
+    }
+    return d;
+}
+
+// ============================================================
+// Persistence (caller holds g_cacheMutex)
+// ============================================================
+static void loadLocked(const Options& opt) {
+    if (g_loaded) return;
+    g_loaded = true;
+
+    std::ifstream f(opt.path);
+    if (!f) return;
+
+    auto j = nlohmann::json::parse(f, nullptr, false);
+    if (j.is_discarded() || !j.contains("entries") || !j["entries"].is_array()) {
+        LOG_ERROR("AI", "Ignoring unreadable response cache: " + opt.path);
+        return;
+    }
+
+    long long now = nowSeconds();
+    for (const auto& e : j["entries"]) {   // stored most recent first
+        Node n;
+        n.prompt       = e.value("prompt", "");
+        n.model        = e.value("model", "");
+        n.backend      = e.value("backend", "");
+        n.reply        = e.value("reply", "");
+        n.created      = e.value("created", 0LL);
+        n.generationMs = e.value("generation_ms", 0.0);
+        if (n.prompt.empty() || n.reply.empty()) continue;
+        if (opt.ttlSeconds > 0 && now - n.created > opt.ttlSeconds) continue;
+        if (g_lru.size() >= static_cast<size_t>(opt.capacity)) break;
+
+        n.key   = makeKey(n.prompt, n.model, n.backend);
+        n.grams = trigrams(n.prompt);
+        if (g_index.count(n.key)) continue;
+        g_lru.push_back(std::move(n));
+        g_index[g_lru.back().key] = std::prev(g_lru.end());
+    }
+    LOG_DEBUG("AI", "Response cache loaded: " + std::to_string(g_lru.size()) + " entries");
+}
+
+// Copy of what gets written; serializing and the file I/O happen
+// after the lock is released
+static nlohmann::json snapshotLocked() {
+    nlohmann::json entries = nlohmann::json::array();
+    for (const auto& n : g_lru) {
+        entries.push_back({
+            {"prompt", n.prompt},
+            {"model", n.model},
+            {"backend", n.backend},
+            {"reply", n.reply},
+            {"created", n.created},
+            {"generation_ms", n.generationMs}
+        });
+    }
+    return entries;
+}
+
+// Temp file, then rename: readers never see a half-written cache
+static bool writeFile(const std::string& path, const nlohmann::json& entries) {
+    fs::path target(path);
+    fs::path tmp = target;
+    tmp += ".tmp";
+    try {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f) return false;
+        f << nlohmann::json{{"entries", entries}}.dump(2);
+        if (!f) return false;
+    } catch (const std::exception& e) {
+        LOG_ERROR("AI", std::string("Failed to save response cache: ") + e.what());
+        return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, target, ec);
+    return !ec;
+}
+
+static bool expiredLocked(const Node& n, const Options& opt, long long now) {
+    return opt.ttlSeconds > 0 && now - n.created > opt.ttlSeconds;
+}
+
+static void eraseLocked(std::list<Node>::iterator it) {
+    g_index.erase(it->key);
+    g_lru.erase(it);
+}
+
+// ============================================================
+// Lookup / store
+// ============================================================
+std::optional<std::string> lookup(const std::string& prompt,
+                                  const std::string& model,
+                                  const std::string& backend) {
+    Options opt = options();
+    if (!opt.enabled) return std::nullopt;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::string norm = normalize(prompt);
+    if (norm.empty()) return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    loadLocked(opt);
+    g_stats.lookups++;
+    long long now = nowSeconds();
+
+    auto found = g_lru.end();
+    auto it = g_index.find(makeKey(norm, model, backend));
+    if (it != g_index.end()) {
+        found = it->second;
+    } else if (opt.fuzzy) {
+        auto grams  = trigrams(norm);
+        auto digits = digitsOf(norm);
+        double best = opt.minSimilarity;
+        for (auto n = g_lru.begin(); n != g_lru.end(); ++n) {
+            if (n->model != model || n->backend != backend) continue;
+            if (digitsOf(n->prompt) != digits) continue;
+            double sim = similarity(grams, n->grams);
+            if (sim >= best) {
+                best  = sim;
+                found = n;
+            }
+        }
+        if (found != g_lru.end()) g_stats.fuzzyHits++;
+    }
+
+    if (found == g_lru.end()) return std::nullopt;
+    if (expiredLocked(*found, opt, now)) {
+        eraseLocked(found);
+        g_dirty = true;
+        g_stats.expired++;
+        return std::nullopt;
+    }
+
+    g_lru.splice(g_lru.begin(), g_lru, found);
+    g_stats.hits++;
+    g_stats.savedMs  += found->generationMs;
+    g_stats.lookupMs += std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+    return found->reply;
+}
+
+void store(const std::string& prompt,
+           const std::string& model,
+           const std::string& backend,
+           const std::string& reply,
+           double generationMs) {
+    Options opt = options();
+    std::string norm = normalize(prompt);
+    if (!opt.enabled || norm.empty() || reply.empty()) return;
+
+    std::unique_lock<std::mutex> lock(g_cacheMutex);
+    loadLocked(opt);
+
+    std::string k = makeKey(norm, model, backend);
+    auto it = g_index.find(k);
+    if (it != g_index.end()) eraseLocked(it->second);
+
+    Node n;
+    n.key          = k;
+    n.prompt       = norm;
+    n.model        = model;
+    n.backend      = backend;
+    n.reply        = reply;
+    n.created      = nowSeconds();
+    n.generationMs = generationMs;
+    n.grams        = trigrams(norm);
+    g_lru.push_front(std::move(n));
+    g_index[k] = g_lru.begin();
+    g_stats.stores++;
+
+    while (g_lru.size() > static_cast<size_t>(opt.capacity)) {
+        eraseLocked(std::prev(g_lru.end()));
+        g_stats.evictions++;
+    }
+    g_dirty = true;
+
+    // One background save per interval; a dropped job is retried next time
+    auto now = std::chrono::steady_clock::now();
+    bool due = now - g_lastSave >= SAVE_INTERVAL;
+    if (due) g_lastSave = now;
+    lock.unlock();
+
+    if (due) {
+        AIExecutor::submit([](const AIExecutor::Context&) {
+            save();
+            return std::string();
+        }, {AIExecutor::Priority::Background});
+    }
+}
+
+void save() {
+    std::lock_guard<std::mutex> saveLock(g_saveMutex);
+    Options opt = options();
+    nlohmann::json entries;
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        if (!g_dirty) return;
+        entries    = snapshotLocked();
+        g_dirty    = false;
+        g_lastSave = std::chrono::steady_clock::now();
+    }
+    if (!writeFile(opt.path, entries)) {
+        LOG_ERROR("AI", "Could not write response cache: " + opt.path);
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        g_dirty = true;
+    }
+}
+
+void clear() {
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        g_lru.clear();
+        g_index.clear();
+        g_loaded = true;
+        g_stats  = Stats{};
+        g_dirty  = true;
+    }
+    save();
+}
+
+Stats getStats() {
+    Options opt = options();
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    loadLocked(opt);
+    Stats s = g_stats;
+    s.size     = g_lru.size();
+    s.capacity = opt.enabled ? static_cast<size_t>(opt.capacity) : 0;
+    return s;
+}
+
+} // namespace ResponseCache
@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <optional>
+
+// ============================================================
+// ResponseCache — prompt → AI reply, persisted across runs
+// ============================================================
+// - Keyed by normalized prompt (lowercase, single spaces, no
+//   trailing punctuation) + model + backend. No conversation in
+//   the key: ai_process only uses it for context-free prompts.
+// - Optional approximate matching: character-trigram similarity
+//   against entries for the same model and backend. Prompts with
+//   different numbers never match approximately.
+// - Entries expire after ttl_s; the least recently used entry is
+//   dropped beyond capacity.
+// - Saved to ai_config.json "response_cache.path" (relative to the
+//   resource directory) in the background while changed, and at
+//   shutdown; never on the reply path.
+// ============================================================
+namespace ResponseCache {
+    struct Options {
+        bool        enabled       = true;
+        int         capacity      = 200;
+        int         ttlSeconds    = 86400;
+        bool        fuzzy         = false;
+        double      minSimilarity = 0.9;    // trigram Dice coefficient
+        std::string path          = "response_cache.json";
+    };
+    Options loadOptions();
+
+    // Snapshot the options from aiConfig (main thread, after the config
+    // loads); lookup/store may run on any thread and only use this copy
+    void    init();
+    Options options();
+
+    std::optional<std::string> lookup(const std::string& prompt,
+                                      const std::string& model,
+                                      const std::string& backend);
+
+    // generationMs: what the backend took, credited on later hits
+    void store(const std::string& prompt,
+               const std::string& model,
+               const std::string& backend,
+               const std::string& reply,
+               double generationMs);
+
+    // Drop every entry (and the file contents) and reset counters
+    void clear();
+
+    // Write the entries if they changed since the last save (shutdown;
+    // store() also schedules one in the background at most once a minute)
+    void save();
+
+    struct Stats {
+        uint64_t lookups   = 0;
+        uint64_t hits      = 0;   // exact + fuzzy
+        uint64_t fuzzyHits = 0;
+        uint64_t expired   = 0;
+        uint64_t evictions = 0;
+        uint64_t stores    = 0;
+        double   lookupMs  = 0.0; // summed over hits
+        double   savedMs   = 0.0; // generation time of the replies served
+        size_t   size      = 0;
+        size_t   capacity  = 0;
+    };
+    Stats getStats();
+}
@@ -0,0 +1,201 @@
+#include "ai_stream.hpp"
+#include "ai_http.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+namespace AIStream {
+
+// ---------------- Stats ----------------
+static std::mutex g_statsMutex;
+static Stats      g_stats;
+
+// Raw bytes kept for the error message on a non-200 reply
+constexpr size_t MAX_ERROR_BYTES = 512;
+
+// ============================================================
+// Parser
+// ============================================================
+Parser::Parser(Format format, TokenFn onToken)
+    : format_(format), onToken_(std::move(onToken)) {}
+
+void Parser::feed(std::string_view bytes) {
+    pending_.append(bytes.data(), bytes.size());
+
+    size_t start = 0;
+    size_t nl;
+    while ((nl = pending_.find('\n', start)) != std::string::npos) {
+        std::string_view line(pending_.data() + start, nl - start);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        handleLine(line);
+        start = nl + 1;
+    }
+    pending_.erase(0, start);
+}
+
+void Parser::finish() {
+    if (!pending_.empty()) {
+        std::string rest;
+        rest.swap(pending_);
+        handleLine(rest);
+    }
+}
+
+void Parser::handleLine(std::string_view line) {
+    if (line.empty() || done_) return;
+
+    if (format_ == Format::SSE) {
+        // Only "data:" fields carry payload; comments / event names are skipped
+        if (line.rfind("data:", 0) != 0) return;
+        line.remove_prefix(5);
+        while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+
+        if (line == "[DONE]") {
+            done_ = true;
+            return;
+        }
+
+        auto j = nlohmann::json::parse(line, nullptr, false);
+        if (j.is_discarded()) return;
+        if (j.contains("error")) {
+            error_ = j["error"].is_object() ? j["error"].value("message", "error")
+                                            : j["error"].dump();
+            return;
+        }
+        if (!j.contains("choices") || j["choices"].empty()) return;
+
+        const auto& choice = j["choices"][0];
+        if (choice.contains("delta") && choice["delta"].contains("content") &&
+            choice["delta"]["content"].is_string()) {
+            std::string token = choice["delta"]["content"].get<std::string>();
+            if (!token.empty()) {
+                tokens_++;
+                if (onToken_) onToken_(token);
+            }
+        }
+        return;
+    }
+
+    // NDJSON: one object per line
+    auto j = nlohmann::json::parse(line, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) return;
+    if (j.contains("error")) {
+        error_ = j["error"].is_string() ? j["error"].get<std::string>() : j["error"].dump();
+        return;
+    }
+
+    std::string token = j.value("response", "");
+    if (!token.empty()) {
+        tokens_++;
+        if (onToken_) onToken_(token);
+    }
+    if (j.value("done", false)) {
+        done_  = true;
+        final_ = std::move(j);
+    }
+}
+
+// ============================================================
+// Streaming POST
+// ============================================================
+Result post(const std::string& url,
+            const std::map<std::string, std::string>& headers,
+            const std::string& body,
+            Format format,
+            const TokenFn& onToken,
+            int timeoutMs,
+            const AIExecutor::CancelToken& cancel) {
+    Result result;
+    auto t0 = std::chrono::steady_clock::now();
+    auto sinceStart = [&t0] {
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - t0).count();
+    };
+
+    std::string errorBytes;
+    Parser parser(format, [&](const std::string& token) {
+        if (result.ttftMs < 0.0) result.ttftMs = sinceStart();
+        if (onToken) onToken(token);
+    });
+
+    cpr::Header cprHeaders;
+    for (const auto& [k, v] : headers) cprHeaders[k] = v;
+
+    try {
+        cpr::WriteCallback onBytes{[&](std::string_view data, intptr_t) -> bool {
+            result.bytes += data.size();
+            if (errorBytes.size() < MAX_ERROR_BYTES) {
+                errorBytes.append(data.substr(0, MAX_ERROR_BYTES - errorBytes.size()));
+            }
+            // Tokens already in this slice are dropped too: nobody wants them
+            if (cancel.cancelled()) return false;
+            parser.feed(data);
+            return true;
+        }};
+        cpr::Response resp = HttpPool::post(url, cprHeaders, body, timeoutMs, &onBytes,
+                                            [&cancel] { return cancel.cancelled(); });
+        parser.finish();
+
+        result.status    = resp.status_code;
+        result.cancelled = cancel.cancelled();
+        if (result.cancelled) {
+            result.error = "cancelled";
+        } else if (resp.error) {
+            result.error = resp.error.message;
+        } else if (resp.status_code != 200) {
+            result.error = "HTTP " + std::to_string(resp.status_code) + ": " + errorBytes;
+        } else if (!parser.error().empty()) {
+            result.error = parser.error();
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    result.totalMs = sinceStart();
+    result.tokens  = parser.tokens();
+    result.final   = parser.finalObject();
+    result.ok      = result.error.empty() && result.status == 200;
+
+    {
+        std::lock_guard<std::mutex> lock(g_statsMutex);
+        g_stats.requests++;
+        g_stats.tokens  += result.tokens;
+        g_stats.totalMs += result.totalMs;
+        if (result.cancelled) {
+            g_stats.cancelled++;
+        } else if (!result.ok) {
+            g_stats.failures++;
+        }
+        if (result.ttftMs >= 0.0) {
+            g_stats.ttftMs += result.ttftMs;
+            g_stats.ttftCount++;
+            g_stats.maxTtftMs = std::max(g_stats.maxTtftMs, result.ttftMs);
+        }
+    }
+
+    if (result.cancelled) {
+        LOG_DEBUG("AI", "Stream cancelled after " + std::to_string(result.totalMs) + " ms, " +
+                        std::to_string(result.tokens) + " tokens");
+    } else if (!result.ok) {
+        LOG_ERROR("AI", "Stream request failed: " + result.error);
+    } else {
+        LOG_DEBUG("AI", "Stream: first token " + std::to_string(result.ttftMs) + " ms, total " +
+                        std::to_string(result.totalMs) + " ms, " +
+                        std::to_string(result.tokens) + " tokens");
+    }
+    return result;
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    return g_stats;
+}
+
+void resetStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    g_stats = Stats{};
+}
+
+} // namespace AIStream
@@ -0,0 +1,90 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <map>
+#include <functional>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "ai_executor.hpp"
+
+// ============================================================
+// AIStream — incremental HTTP streaming for AI backends
+// ============================================================
+// - Parser turns raw body bytes into tokens as they arrive:
+//     NDJSON: Ollama /api/generate ({"response": "...", "done": ...})
+//     SSE:    OpenAI-compatible chat ("data: {...}" / "data: [DONE]")
+// - post() wires a Parser to a cpr write callback, so onToken
+//   fires per token instead of after the whole body is received.
+// - Time-to-first-token and total latency are recorded per call.
+// - Cancelling the token closes the connection mid-stream, which
+//   stops generation on backends that watch for disconnects.
+// ============================================================
+namespace AIStream {
+    enum class Format { NDJSON, SSE };
+
+    using TokenFn = std::function<void(const std::string&)>;
+
+    class Parser {
+    public:
+        Parser(Format format, TokenFn onToken);
+
+        // Feed any slice of the body; lines may be split anywhere
+        void feed(std::string_view bytes);
+
+        // End of body: handle a trailing line without newline
+        void finish();
+
+        bool   done()   const { return done_; }
+        size_t tokens() const { return tokens_; }
+        const std::string& error() const { return error_; }
+
+        // Last complete NDJSON object with "done": true (Ollama puts
+        // "context" and timing fields there); null for SSE
+        const nlohmann::json& finalObject() const { return final_; }
+
+    private:
+        void handleLine(std::string_view line);
+
+        Format      format_;
+        TokenFn     onToken_;
+        std::string pending_;      // bytes after the last newline
+        bool        done_   = false;
+        size_t      tokens_ = 0;
+        std::string error_;
+        nlohmann::json final_;
+    };
+
+    struct Result {
+        bool   ok       = false;
+        long   status   = 0;
+        double ttftMs   = -1.0;   // request start → first token (-1 = none)
+        double totalMs  = 0.0;
+        size_t tokens   = 0;
+        size_t bytes    = 0;
+        bool   cancelled = false;
+        std::string    error;
+        nlohmann::json final;
+    };
+
+    // POST body to url and stream the response through a Parser.
+    Result post(const std::string& url,
+                const std::map<std::string, std::string>& headers,
+                const std::string& body,
+                Format format,
+                const TokenFn& onToken,
+                int timeoutMs = 60000,
+                const AIExecutor::CancelToken& cancel = AIExecutor::CancelToken{});
+
+    struct Stats {
+        uint64_t requests  = 0;
+        uint64_t failures  = 0;
+        uint64_t cancelled = 0;
+        uint64_t tokens    = 0;
+        double   ttftMs    = 0.0;   // summed over requests that produced a token
+        double   maxTtftMs = 0.0;
+        uint64_t ttftCount = 0;
+        double   totalMs   = 0.0;
+    };
+    Stats getStats();
+    void  resetStats();
+}
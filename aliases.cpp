@@ -26,6 +26,9 @@ static const std::string ALIAS_FILE = "app_aliases.json";
 // 🔹 Reentrancy guard for async refresh
 static std::atomic<bool> isRefreshing{false};
 
+// 🔹 Bumped on every change to g_aliases (intent cache invalidation)
+static std::atomic<uint64_t> g_aliasVersion{0};
+
 // ------------------------------------------------------------
 // Internal helpers
 // ------------------------------------------------------------
@@ -68,12 +71,14 @@ void init() {
     try {
         // Always start with clean structure
         g_aliases = { {"user", nlohmann::json::object()}, {"auto", nlohmann::json::object()} };
+        g_aliasVersion++;
         load(); // load() locks internally
     } catch (const std::exception& e) {
         LOG_ERROR("Aliases", std::string("Exception during init: ") + e.what());
         LOG_PHASE("Aliases init", false);
 
         g_aliases = { {"user", nlohmann::json::object()}, {"auto", nlohmann::json::object()} };
+        g_aliasVersion++;
         saveLocked();
     }
 
@@ -97,6 +102,7 @@ void load() {
 
         g_aliases = loaded;
         ensureStructure();
+        g_aliasVersion++;
 
         LOG_PHASE("Aliases load", true);
         LOG_DEBUG("Aliases", "Loaded " + ALIAS_FILE + " successfully");
@@ -105,6 +111,7 @@ void load() {
         LOG_PHASE("Aliases load", false);
 
         g_aliases = { {"user", nlohmann::json::object()}, {"auto", nlohmann::json::object()} };
+        g_aliasVersion++;
         saveLocked();
     }
 }
@@ -121,6 +128,7 @@ void refreshAsync() {
         {
             std::scoped_lock lock(g_aliasMutex);
             g_aliases["auto"]["timestamp"] = std::time(nullptr);
+            g_aliasVersion++;
         }
 
         saveLocked();
@@ -137,6 +145,7 @@ CommandResult refreshNow() {
     {
         std::scoped_lock lock(g_aliasMutex);
         g_aliases["auto"]["timestamp"] = std::time(nullptr);
+        g_aliasVersion++;
     }
 
     saveLocked();
@@ -184,4 +193,8 @@ std::string info(const std::string& key) {
     return oss.str();
 }
 
+uint64_t version() {
+    return g_aliasVersion.load();
+}
+
 } // namespace aliases
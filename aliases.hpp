@@ -36,4 +36,7 @@ namespace aliases {
     std::unordered_map<std::string, std::string> getAll();
     std::string info(const std::string& key);
 
+    // Incremented whenever the alias table is loaded or refreshed
+    uint64_t version();
+
 } // namespace aliases
@@ -5,6 +5,7 @@
 #include "aliases.hpp"
 #include "system_detect.hpp"
 #include "voice/voice_speak.hpp"
+#include "voice/whisper_pool.hpp"
 #include "device_setups/audio_devices.hpp"
 #include "logger.hpp"
 
@@ -53,6 +54,16 @@ void runBootstrapChecks(int argc, char** argv) {
     logSystemInfo(g_systemInfo);
     LOG_PHASE("System detection", true);
 
+    // ============================================================
+    // Whisper model (background load + warm-up)
+    // ============================================================
+    if (aiConfig.contains("whisper") && aiConfig["whisper"].value("preload", true)) {
+        WhisperPool::preload(aiConfig);
+        LOG_PHASE("Whisper preload started", true);
+    } else {
+        LOG_PHASE("Whisper preload skipped", true);
+    }
+
     // ============================================================
     // Voice system (Coqui bridge)
     // ============================================================
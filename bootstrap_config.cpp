@@ -5,6 +5,9 @@
 #include "nlp/nlp.hpp"
 #include "console_history.hpp"
 #include "ai/ai.hpp"
+#include "ai/ai_backend.hpp"
+#include "ai/ai_executor.hpp"
+#include "ai/ai_response_cache.hpp"
 #include "logger.hpp"
 
 namespace fs = std::filesystem;
@@ -55,6 +58,8 @@ nlohmann::json defaultAI() {
             {"local_engine", "en_US-amy-medium.onnx"},
             {"speaker", "p225"},
             {"speed", 1.0},
+            {"stream_pcm", true},
+            {"look_ahead", 2},
             {"rules", {
                 {"startup", "sapi"},
                 {"reminder", "coqui"},
@@ -62,6 +67,26 @@ nlohmann::json defaultAI() {
                 {"banter", "coqui"}
             }},
             {"input_device_index", -1},
+            {"vad", {
+                {"min_rms", 0.005},
+                {"noise_ratio", 3.0},
+                {"max_noise_zcr", 0.35},
+                {"attack_frames", 2},
+                {"hangover_frames", 15},
+                {"adapt_rate", 0.05}
+            }},
+            {"sentences", {
+                {"enabled", true},
+                {"min_chars", 12},
+                {"max_chars", 220}
+            }},
+            {"cache", {
+                {"enabled", true},
+                {"memory_mb", 32},
+                {"disk_mb", 256},
+                {"max_chars", 160},
+                {"dir", (fs::path(getResourcePath()) / "tts_cache").string()}
+            }},
             {"coqui", {
                 {"model", "tts_models/en/vctk/vits"},
                 {"speaker", "p225"}
@@ -77,11 +102,90 @@ nlohmann::json defaultAI() {
             {"azure", ""}
         }},
 
+        {"http", {
+            {"connect_timeout_ms", 2000},
+            {"timeout_ms", 60000},
+            {"keep_alive", true},
+            {"max_idle_per_host", 4}
+        }},
+
+        {"executor", {
+            {"workers", 2},
+            {"queue_size", 16}
+        }},
+
+        {"barge_in", {
+            {"enabled", true},
+            {"min_speech_ms", 250},
+            {"over_playback", true},
+            {"echo_ratio", 4.0},
+            {"echo_learn_ms", 300}
+        }},
+
+        {"backend_health", {
+            {"refresh_ms", 30000},
+            {"backoff_min_ms", 1000},
+            {"backoff_max_ms", 60000},
+            {"probe_timeout_ms", 1000}
+        }},
+
+        {"conversation", {
+            {"enabled", true},
+            {"max_tokens", 2048},
+            {"max_turns", 20},
+            {"reuse_kv", true}
+        }},
+
+        {"response_cache", {
+            {"enabled", true},
+            {"capacity", 200},
+            {"ttl_s", 86400},
+            {"fuzzy", false},
+            {"min_similarity", 0.9},
+            {"path", "response_cache.json"}
+        }},
+
+        {"intent_cache", {
+            {"enabled", true},
+            {"capacity", 256}
+        }},
+
         {"whisper", {
             {"sampling_strategy", "beam"},
             {"temperature", 0.2},
             {"min_speech_ms", 500},
-            {"min_silence_ms", 1200}
+            {"min_silence_ms", 1200},
+            {"pool_size", 2},
+            {"preload", true},
+            {"bulk_read", true},
+            {"profile", "balanced"},
+            {"short_mode", {
+                {"enabled", true},
+                {"max_ms", 10000},
+                {"margin_ms", 1000}
+            }},
+            {"constrained", {
+                {"enabled", false},
+                {"bias", 2.0},
+                {"max_tokens", 16},
+                {"min_prob", 0.45},
+                {"prompt_words", 48}
+            }},
+            {"profiles", {
+                {"latency",  {{"strategy", "greedy"}, {"max_tokens", 24}}},
+                {"balanced", nlohmann::json::object()},
+                {"accuracy", {{"strategy", "beam"}, {"beam_size", 5}, {"temperature_inc", 0.2}}}
+            }},
+            {"stream", {
+                {"window_ms", 4000},
+                {"stride_ms", 1000},
+                {"prompt_tokens", 64},
+                {"speculative", {
+                    {"enabled", true},
+                    {"confirm_ms", 400},
+                    {"min_confidence", 0.5}
+                }}
+            }}
         }}
     };
 }
@@ -169,6 +273,11 @@ void initAll() {
     fs::path cfgPath = fs::current_path() / AI_CONFIG_FILE;
     loadConfig(cfgPath, defaultAI(), aiConfig, "AI config", "ERR_AI_CONFIG_INVALID");
 
+    // AI requests run on executor workers: give them copies, not aiConfig
+    AIExecutor::init();
+    ResponseCache::init();
+    AIBackend::configure(aiConfig);
+
     // errors.json
     fs::path errPath = fs::path(getResourcePath()) / "errors.json";
     nlohmann::json errorsCfg;
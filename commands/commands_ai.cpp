@@ -4,7 +4,18 @@
 #include "system_detect.hpp"
 #include "aliases.hpp"     // 🔹 for app alias resolution
 #include "nlp/nlp.hpp"
+#include "nlp/intent_cache.hpp"
 #include "ai/ai.hpp"
+#include "ai/ai_stream.hpp"
+#include "ai/ai_backends.hpp"
+#include "ai/ai_http.hpp"
+#include "ai/ai_executor.hpp"
+#include "ai/ai_bargein.hpp"
+#include "ai/ai_response_cache.hpp"
+#include "ai/ai_context.hpp"
+#include "ai/ai_backend.hpp"
+#include "ai/ai_mock_server.hpp"
+#include "voice/voice_capture.hpp"
 
 // External libs not in pch.hpp
 #include <cpr/cpr.h>       // 🔹 Needed for Ollama HTTP
@@ -45,13 +56,27 @@ static std::string autoSelectBackend() {
 CommandResult cmdAiBackend(const std::string& arg) {
     std::string input = trim(arg);
 
-    if (input.empty()) {
+    if (input.empty() || input == "refresh") {
+        if (input == "refresh") BackendRegistry::refreshNow();
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(0);
+        oss << "[AI] Current backend: " << resolveBackendURL();
+        for (const auto& st : BackendRegistry::status()) {
+            const char* health = st.health == BackendRegistry::Health::Healthy ? "healthy"
+                               : st.health == BackendRegistry::Health::Down    ? "down"
+                                                                               : "unknown";
+            oss << "\n - " << st.name << ": " << health << " (probe " << st.lastProbeMs
+                << " ms, " << st.failures << " failures, next check in "
+                << st.nextCheckMs / 1000 << " s)";
+        }
+
         return {
-            "[AI] Current backend: " + resolveBackendURL(),
+            oss.str(),
             true,
             sf::Color::Cyan,
             "ERR_NONE",
-            "Current AI backend",
+            ResponseManager::voiceLine("current_ai_backend"),
             "summary"
         };
     }
@@ -77,7 +102,7 @@ CommandResult cmdAiBackend(const std::string& arg) {
         false,
         sf::Color::Red,
         "ERR_AI_INVALID_BACKEND",
-        "Invalid backend",
+        ResponseManager::voiceLine("invalid_backend"),
         "error"
     };
 }
@@ -88,15 +113,515 @@ CommandResult cmdAiBackend(const std::string& arg) {
 CommandResult cmdReloadNlp(const std::string& /*arg*/) {
     CommandResult r = reloadNlpRules();
     if (r.success) {
-        r.voice = "NLP rules reloaded";
+        r.voice = ResponseManager::voiceLine("nlp_rules_reloaded");
         r.category = "routine";
     } else {
-        r.voice = "Failed to reload NLP rules";
+        r.voice = ResponseManager::voiceLine("failed_to_reload_nlp_rules");
         r.category = "error";
     }
     return r;
 }
 
+// ------------------------------------------------------------
+// [NLP] Intent cache stats
+// ------------------------------------------------------------
+CommandResult cmdIntentCache(const std::string& arg) {
+    if (arg == "clear") {
+        IntentCache::clear();
+        return { "[NLP] Intent cache cleared.", true, sf::Color::Yellow,
+                 "ERR_NONE", "", "debug" };
+    }
+
+    IntentCache::Stats st = IntentCache::getStats();
+    double hitRate = st.lookups ? 100.0 * st.hits / st.lookups : 0.0;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "[NLP] Intent cache\n";
+    oss << " - Entries   : " << st.size << " / " << st.capacity
+        << " (" << st.evictions << " evicted, " << st.invalidations << " reload clears)\n";
+    oss << " - Hit rate  : " << st.hits << "/" << st.lookups << " (" << hitRate << "%)\n";
+    oss << " - Saved     : normalize " << st.savedNormalizeMs << " ms, parse "
+        << st.savedParseMs << " ms, alias " << st.savedAliasMs << " ms\n";
+
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Response cache
+// ------------------------------------------------------------
+CommandResult cmdAiCache(const std::string& arg) {
+    if (arg == "clear") {
+        ResponseCache::clear();
+        return { "[AI] Response cache cleared.", true, sf::Color::Yellow,
+                 "ERR_NONE", "", "debug" };
+    }
+
+    ResponseCache::Options opt = ResponseCache::options();
+    ResponseCache::Stats st = ResponseCache::getStats();
+    double hitRate = st.lookups ? 100.0 * st.hits / st.lookups : 0.0;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "[AI] Response cache (" << opt.path << ")\n";
+    oss << " - Entries   : " << st.size << " / " << st.capacity << " (" << st.evictions
+        << " evicted, " << st.expired << " expired, ttl " << opt.ttlSeconds << " s)\n";
+    oss << " - Hit rate  : " << st.hits << "/" << st.lookups << " (" << hitRate << "%), "
+        << st.fuzzyHits << " approximate" << (opt.fuzzy ? "" : " [off]") << "\n";
+    oss << " - Hit time  : avg " << (st.hits ? st.lookupMs / st.hits : 0.0)
+        << " ms, generation saved " << st.savedMs << " ms\n";
+
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Conversation context
+// ------------------------------------------------------------
+CommandResult cmdAiContext(const std::string& arg) {
+    if (arg == "reset") {
+        Conversation::reset();
+        return { "[AI] Conversation cleared.", true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+    }
+
+    Conversation::Options opt = Conversation::loadOptions();
+    Conversation::Stats st = Conversation::getStats();
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[AI] Conversation" << (opt.enabled ? "" : " [off]") << "\n";
+    oss << " - Transcript : " << st.turns << " messages, ~" << st.transcriptTokens << " / "
+        << opt.maxTokens << " tokens (" << st.trimmedTurns << " trimmed)\n";
+    oss << " - KV context : " << st.contextTokens << " tokens held, " << st.kvReused
+        << " turns reused it, " << st.rebuilds << " rebuilt from text\n";
+    if (st.promptEvalTurns > 0) {
+        oss << " - Prompt eval: avg " << static_cast<double>(st.promptEvalCount) / st.promptEvalTurns
+            << " tokens, " << st.promptEvalMs / st.promptEvalTurns << " ms per turn\n";
+    }
+
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Streaming stats
+// ------------------------------------------------------------
+CommandResult cmdAiStats(const std::string& arg) {
+    if (arg == "reset") {
+        AIStream::resetStats();
+        HttpPool::resetStats();
+        AIExecutor::resetStats();
+        AIBackend::resetStats();
+        return { "[AI] Stats reset.", true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+    }
+
+    AIStream::Stats st = AIStream::getStats();
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[AI] Streaming stats\n";
+    oss << " - Requests    : " << st.requests << " (" << st.failures << " failed)\n";
+    oss << " - First token : avg " << (st.ttftCount ? st.ttftMs / st.ttftCount : 0.0)
+        << " ms, max " << st.maxTtftMs << " ms\n";
+    oss << " - Total       : avg " << (st.requests ? st.totalMs / st.requests : 0.0) << " ms, "
+        << st.tokens << " tokens\n";
+
+    HttpPool::Stats hp = HttpPool::getStats();
+    oss << " - HTTP pool   : " << hp.requests << " requests, " << hp.reused << " reused, "
+        << hp.created << " new, " << hp.discarded << " dropped, " << hp.idle << " idle\n";
+
+    for (const auto& [name, bs] : AIBackend::allStats()) {
+        uint64_t ok = bs.requests - bs.failures - bs.cancelled;
+        oss << " - " << name << " : " << bs.requests << " requests, " << bs.failures
+            << " failed, " << bs.cancelled << " cancelled, avg "
+            << (ok ? bs.totalMs / ok : 0.0) << " ms\n";
+    }
+
+    ResponseCache::Stats rc = ResponseCache::getStats();
+    oss << " - Reply cache : " << rc.hits << "/" << rc.lookups << " hits, avg "
+        << (rc.hits ? rc.lookupMs / rc.hits : 0.0) << " ms, " << rc.savedMs << " ms saved\n";
+
+    AIExecutor::Stats ex = AIExecutor::getStats();
+    oss << " - Executor    : " << ex.workers << " workers, " << ex.active << " busy, "
+        << ex.queued << " queued (max " << ex.maxQueued << ")\n";
+    oss << "                 " << ex.completed << " done, " << ex.cancelled << " cancelled, "
+        << ex.expired << " expired, " << ex.dropped << " dropped, avg wait "
+        << (ex.submitted ? ex.waitMs / ex.submitted : 0.0) << " ms\n";
+
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Streaming vs buffered against the local stand-in server
+// ------------------------------------------------------------
+CommandResult cmdAiStreamTest(const std::string& arg) {
+    MockLLM::Options opt;
+    std::istringstream iss(arg);
+    iss >> opt.firstTokenMs >> opt.tokenMs >> opt.tokens;
+
+    bool ownServer = !MockLLM::running();
+    if (ownServer && !MockLLM::start(opt)) {
+        return { "[AI] Could not start the stand-in server.", false, sf::Color::Red,
+                 "ERR_AI_BACKEND_UNAVAILABLE", "", "error" };
+    }
+
+    struct Case { const char* name; const char* path; AIStream::Format format; nlohmann::json body; };
+    const std::vector<Case> cases = {
+        { "ollama ndjson", "/api/generate", AIStream::Format::NDJSON,
+          {{"model", "mock"}, {"prompt", "hello"}, {"stream", true}} },
+        { "openai sse", "/v1/chat/completions", AIStream::Format::SSE,
+          {{"model", "mock"}, {"stream", true},
+           {"messages", nlohmann::json::array({{{"role", "user"}, {"content", "hello"}}})}} }
+    };
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[AI] Stream test (" << MockLLM::baseUrl() << ", first token " << opt.firstTokenMs
+        << " ms, " << opt.tokens << " tokens @ " << opt.tokenMs << " ms)\n";
+
+    for (const auto& c : cases) {
+        std::string url = MockLLM::baseUrl() + c.path;
+
+        // Buffered: the old path, first token only once the body is complete
+        auto t0 = std::chrono::steady_clock::now();
+        auto buffered = cpr::Post(cpr::Url{url},
+                                  cpr::Header{{"Content-Type", "application/json"}},
+                                  cpr::Body{c.body.dump()},
+                                  cpr::Timeout{60000});
+        double bufferedMs = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - t0).count();
+
+        AIStream::Result r = AIStream::post(url, {{"Content-Type", "application/json"}},
+                                            c.body.dump(), c.format, nullptr);
+
+        oss << " - " << c.name << " : ";
+        if (!r.ok || buffered.status_code != 200) {
+            oss << "failed (" << r.error << ")\n";
+            continue;
+        }
+        oss << "first token " << r.ttftMs << " ms streamed vs " << bufferedMs
+            << " ms buffered, total " << r.totalMs << " ms, " << r.tokens << " tokens\n";
+    }
+
+    if (ownServer) MockLLM::stop();
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Connection reuse benchmark
+// ------------------------------------------------------------
+CommandResult cmdAiHttpBench(const std::string& arg) {
+    int requests = 50;
+    std::istringstream(arg) >> requests;
+    requests = std::clamp(requests, 2, 10000);
+
+    // Tiny instant replies so connection setup dominates
+    MockLLM::Options opt;
+    opt.firstTokenMs = 0;
+    opt.tokenMs      = 0;
+    opt.tokens       = 8;
+
+    bool ownServer = !MockLLM::running();
+    if (ownServer && !MockLLM::start(opt)) {
+        return { "[AI] Could not start the stand-in server.", false, sf::Color::Red,
+                 "ERR_AI_BACKEND_UNAVAILABLE", "", "error" };
+    }
+
+    std::string url  = MockLLM::baseUrl() + "/api/generate";
+    std::string body = nlohmann::json{{"model", "mock"}, {"prompt", "ping"}, {"stream", false}}.dump();
+
+    auto summarize = [](std::vector<double> v, std::ostringstream& out) {
+        if (v.empty()) {
+            out << "failed\n";
+            return;
+        }
+        double first = v.front();
+        std::sort(v.begin(), v.end());
+        double sum = 0.0;
+        for (double x : v) sum += x;
+        out << "avg " << sum / v.size() << " ms, p50 " << v[v.size() / 2] << " ms, p95 "
+            << v[std::min(v.size() - 1, v.size() * 95 / 100)] << " ms (first " << first << " ms)\n";
+    };
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "[AI] HTTP bench: " << requests << " sequential requests to " << url << "\n";
+    oss << " - New connection : ";
+    summarize(HttpPool::bench(url, body, requests, false), oss);
+    oss << " - Pooled session : ";
+    summarize(HttpPool::bench(url, body, requests, true), oss);
+
+    if (ownServer) {
+        HttpPool::clear();   // close kept-alive connections before the server goes
+        MockLLM::stop();
+    }
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Barge-in replay benchmark
+// ------------------------------------------------------------
+CommandResult cmdAiBargeInBench(const std::string& arg) {
+    int turns = 4, interruptMs = 800;
+    std::istringstream(arg) >> turns >> interruptMs;
+    turns       = std::clamp(turns, 2, 50);
+    interruptMs = std::clamp(interruptMs, 50, 60000);
+
+    // Replies long enough that the user talks over each one
+    MockLLM::Options opt;
+    opt.firstTokenMs = 200;
+    opt.tokenMs      = 30;
+    opt.tokens       = 80;
+
+    bool ownServer = !MockLLM::running();
+    if (ownServer && !MockLLM::start(opt)) {
+        return { "[AI] Could not start the stand-in server.", false, sf::Color::Red,
+                 "ERR_AI_BACKEND_UNAVAILABLE", "", "error" };
+    }
+
+    auto backend = AIBackend::create("ollama", MockLLM::baseUrl());
+
+    struct Run { double generationMs; uint64_t tokens; uint64_t aborted; double lastReplyMs; };
+    auto replay = [&](bool cancel) {
+        MockLLM::resetStats();
+        std::vector<std::future<std::string>> replies;
+        std::vector<AIExecutor::CancelToken> tokens;
+        auto lastTurn = std::chrono::steady_clock::now();
+
+        // Turn i starts interruptMs after turn i-1, as if the user spoke again
+        for (int i = 0; i < turns; i++) {
+            if (i > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(interruptMs));
+                if (cancel) tokens.back().cancel();
+            }
+            tokens.emplace_back();
+            lastTurn = std::chrono::steady_clock::now();
+            replies.push_back(AIExecutor::submit([&](const AIExecutor::Context& ctx) -> std::string {
+                AIQuery query;
+                query.prompt = "hello";
+                query.model  = "mock";
+                query.token  = ctx.token;
+                AIReply r = backend->stream(query, nullptr);
+                return r.cancelled ? AIExecutor::REPLY_CANCELLED : r.error;
+            }, {AIExecutor::Priority::Interactive, tokens.back()}));
+        }
+        replies.back().wait();
+        double lastReplyMs = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - lastTurn).count();
+        for (auto& r : replies) r.wait();
+
+        // Let the server notice closed connections before reading its counters
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.tokenMs * 3));
+        MockLLM::Stats st = MockLLM::getStats();
+        return Run{ st.generationMs, st.tokens, st.aborted, lastReplyMs };
+    };
+
+    Run kept      = replay(false);
+    Run cancelled = replay(true);
+    if (ownServer) {
+        HttpPool::clear();
+        MockLLM::stop();
+    }
+
+    // Mic replay with the reply audible: its echo reaches the VAD as
+    // speech for interruptMs, then the user talks over it. The gate
+    // as configured against one that ignores playback (any speech
+    // counts), block by block as the stream loop feeds it.
+    struct EchoRun { int selfInterrupts = 0; int detected = 0; int missed = 0; double detectMs = 0.0; };
+    auto echoReplay = [&](bool echoAware) {
+        BargeIn::Gate gate;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> jitter(0.5f, 1.5f);
+        const double blockMs = 1000.0 * VoiceCapture::FRAMES_PER_BUFFER / VoiceCapture::SAMPLE_RATE;
+        const float  echoRms = 0.03f, userRms = 0.4f, roomRms = 0.002f;
+
+        EchoRun run;
+        for (int t = 0; t < turns; t++) {
+            bool playing = true;
+            for (double ms = 0.0; playing && ms < interruptMs; ms += blockMs) {
+                if (gate.process(true, echoRms * jitter(rng), echoAware, blockMs)) {
+                    run.selfInterrupts++;
+                    playing = false;   // the reply cut itself off
+                }
+            }
+            bool fired = false;
+            for (double ms = 0.0; playing && ms < 1000.0; ms += blockMs) {
+                // User over the echo: louder, the reply audible until cut
+                if (gate.process(true, userRms * jitter(rng), echoAware, blockMs)) {
+                    run.detected++;
+                    run.detectMs += ms + blockMs;
+                    fired = true;
+                    break;
+                }
+            }
+            if (playing && !fired) run.missed++;
+            for (double ms = 0.0; ms < 1500.0; ms += blockMs) {
+                gate.process(false, roomRms, false, blockMs);
+            }
+        }
+        return run;
+    };
+    EchoRun blind = echoReplay(false);
+    EchoRun aware = echoReplay(true);
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[AI] Barge-in replay: " << turns << " turns, user speaks again every "
+        << interruptMs << " ms\n";
+    auto line = [&oss](const char* name, const Run& r) {
+        oss << " - " << name << " : " << r.generationMs << " ms generating, " << r.tokens
+            << " tokens, " << r.aborted << " aborted, last reply done after "
+            << r.lastReplyMs << " ms\n";
+    };
+    line("No cancel", kept);
+    line("Barge-in ", cancelled);
+    oss << " - Saved     : " << (kept.generationMs - cancelled.generationMs)
+        << " ms of generation, " << (static_cast<long long>(kept.tokens) -
+                                     static_cast<long long>(cancelled.tokens)) << " tokens\n";
+
+    oss << "[AI] Barge-in with the reply audible (echo " << interruptMs
+        << " ms, then the user speaks)\n";
+    auto echoLine = [&oss, turns](const char* name, const EchoRun& r) {
+        oss << " - " << name << " : " << r.selfInterrupts << "/" << turns
+            << " replies cut by their own echo, " << r.detected << " user interrupts (avg "
+            << (r.detected ? r.detectMs / r.detected : 0.0) << " ms after onset), "
+            << r.missed << " missed\n";
+    };
+    echoLine("Echo-blind", blind);
+    echoLine("Echo gate ", aware);
+
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [AI] Latency benchmark of the AI entry points (local stand-in)
+// ------------------------------------------------------------
+CommandResult cmdAiBench(const std::string& arg) {
+    int concurrency = 4, requests = 24, failPercent = 0;
+    std::istringstream(arg) >> concurrency >> requests >> failPercent;
+    concurrency = std::clamp(concurrency, 1, 16);
+    requests    = std::clamp(requests, concurrency, 1000);
+    failPercent = std::clamp(failPercent, 0, 100);
+
+    MockLLM::Options opt;
+    opt.firstTokenMs = 150;
+    opt.tokenMs      = 15;
+    opt.tokens       = 40;
+    opt.failRate     = failPercent / 100.0;
+
+    bool ownServer = !MockLLM::running();
+    MockLLM::Options previous = MockLLM::options();
+    if (ownServer) {
+        if (!MockLLM::start(opt)) {
+            return { "[AI] Could not start the stand-in server.", false, sf::Color::Red,
+                     "ERR_AI_BACKEND_UNAVAILABLE", "", "error" };
+        }
+    } else {
+        MockLLM::setOptions(opt);
+    }
+
+    // The real entry points, pointed at the stand-in; cache, conversation
+    // and memory are left alone so every request reaches the server.
+    // Only requests carrying benchToken are redirected: voice and typed
+    // requests made meanwhile still go to the real backend.
+    auto backend = AIBackend::create("ollama", MockLLM::baseUrl());
+    AIExecutor::CancelToken benchToken;
+    AIBackend::ScopedOverride scoped(*backend, benchToken);
+
+    struct Sample { double ttftMs; double totalMs; bool ok; };
+    using Call = std::function<Sample(int)>;
+
+    auto since = [](std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    };
+    auto prompt = [](int i) { return "benchmark request " + std::to_string(i); };
+
+    const std::vector<std::pair<const char*, Call>> modes = {
+        { "callAIAsync      ", [&](int i) {
+            auto t0 = std::chrono::steady_clock::now();
+            std::string reply = callAIAsync(prompt(i), {AIExecutor::Priority::Normal, benchToken}).get();
+            double ms = since(t0);
+            return Sample{ ms, ms, !AIExecutor::isAborted(reply) && reply.rfind("[AI] ", 0) != 0 };
+        } },
+        { "ai_process       ", [&](int i) {
+            auto t0 = std::chrono::steady_clock::now();
+            CommandResult r = ai_process(prompt(i), {AIExecutor::Priority::Interactive, benchToken});
+            double ms = since(t0);
+            return Sample{ ms, ms, r.success };
+        } },
+        { "ai_process_stream", [&](int i) {
+            nlohmann::json memory = nlohmann::json::object();
+            double ttft = -1.0;
+            auto t0 = std::chrono::steady_clock::now();
+            ai_process_stream(prompt(i), memory, [&](const std::string&) {
+                if (ttft < 0.0) ttft = since(t0);
+            }, {AIExecutor::Priority::Interactive, benchToken});
+            double ms = since(t0);
+            std::string last = memory.value("last_reply", "");
+            return Sample{ ttft < 0.0 ? ms : ttft, ms, !last.empty() && !AIExecutor::isAborted(last) &&
+                                                       last.rfind("[AI] ", 0) != 0 };
+        } }
+    };
+
+    auto percentile = [](std::vector<double> v, int p) {
+        if (v.empty()) return 0.0;
+        std::sort(v.begin(), v.end());
+        return v[std::min(v.size() - 1, v.size() * p / 100)];
+    };
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[AI] Bench: " << requests << " requests, " << concurrency << " concurrent, "
+        << AIExecutor::getStats().workers << " executor workers, " << failPercent
+        << "% server failures\n";
+    oss << "     stand-in " << MockLLM::baseUrl() << ": first token " << opt.firstTokenMs
+        << " ms, " << opt.tokens << " tokens @ " << opt.tokenMs << " ms\n";
+
+    for (const auto& [name, call] : modes) {
+        MockLLM::resetStats();
+        std::vector<Sample> samples(static_cast<size_t>(requests));
+        std::atomic<int> next{0};
+
+        // Each client issues its next request as soon as the last one returns
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> clients;
+        for (int c = 0; c < concurrency; c++) {
+            clients.emplace_back([&] {
+                for (int i = next++; i < requests; i = next++) samples[static_cast<size_t>(i)] = call(i);
+            });
+        }
+        for (auto& t : clients) t.join();
+        double wallMs = since(t0);
+
+        std::vector<double> ttft, total;
+        size_t ok = 0;
+        for (const auto& smp : samples) {
+            if (!smp.ok) continue;
+            ok++;
+            ttft.push_back(smp.ttftMs);
+            total.push_back(smp.totalMs);
+        }
+        MockLLM::Stats st = MockLLM::getStats();
+        double seconds = std::max(wallMs, 1.0) / 1000.0;
+
+        oss << " - " << name << " : " << ok << "/" << requests << " ok";
+        if (ok == 0) {
+            oss << "\n";
+            continue;
+        }
+        oss << ", ttft p50 " << percentile(ttft, 50) << " / p95 " << percentile(ttft, 95)
+            << " ms, total p50 " << percentile(total, 50) << " / p95 " << percentile(total, 95)
+            << " ms\n";
+        oss << "                       " << ok / seconds << " req/s, " << st.tokens / seconds
+            << " tokens/s, " << st.requests << " server requests (" << st.failures << " failed)\n";
+    }
+
+    if (ownServer) {
+        HttpPool::clear();
+        MockLLM::stop();
+    } else {
+        MockLLM::setOptions(previous);
+    }
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
 // ------------------------------------------------------------
 // [AI] General query (catch-all) → grim_ai
 // ------------------------------------------------------------
@@ -107,55 +632,19 @@ CommandResult cmdGrimAi(const std::string& arg) {
     std::string backend = resolveBackendURL();
     std::cerr << "[AI] Current backend resolved: " << backend << "\n";
 
-    // Special handling for Ollama backend
-    if (backend == "ollama") {
-        std::string model  = aiConfig.value("default_model", "mistral");
-        std::string prompt = arg;
+    // New speech or the next request cancels this one (ai_bargein.hpp)
+    AIExecutor::CancelToken turn = BargeIn::beginTurn();
 
-        std::string modelCopy = model;
-        if (modelCopy.find(':') == std::string::npos) {
-            modelCopy += ":latest"; // default tag
-        }
-
-        auto resp = cpr::Post(
-            cpr::Url{ aiConfig.value("ollama_url", "http://127.0.0.1:11434") + "/api/generate" },
-            cpr::Header{{"Content-Type","application/json"}},
-            cpr::Body{ nlohmann::json{
-                {"model", modelCopy},
-                {"prompt", prompt},
-                {"stream", false}   // 🔹 non-streaming mode
-            }.dump() }
-        );
-
-        if (resp.status_code == 200) {
-            auto j = nlohmann::json::parse(resp.text, nullptr, false);
-            if (!j.is_discarded() && j.contains("response")) {
-                std::string reply = j["response"].get<std::string>();
-
-                return {
-                    reply,
-                    true,
-                    sf::Color::Cyan,
-                    "ERR_NONE",
-                    reply,   // voice
-                    "routine"
-                };
-            }
-        }
+    // 🔹 One pipeline for every backend (ai_backend.hpp): cache,
+    //    conversation context, retry and ":latest" tagging included
+    CommandResult result = ai_process(arg, {AIExecutor::Priority::Interactive, turn});
+    BargeIn::endTurn(turn);
 
-        return {
-            "[AI] Ollama backend error",
-            false,
-            sf::Color::Red,
-            "ERR_AI_BACKEND_FAILED",
-            "Ollama backend error",
-            "error"
-        };
+    // Interrupted on purpose: nothing to report or speak
+    if (result.message == AIExecutor::REPLY_CANCELLED) {
+        return { result.message, false, sf::Color(150, 150, 150), "ERR_NONE", "", "routine" };
     }
 
-    // 🔹 Run the default AI pipeline (localai / openai)
-    CommandResult result = ai_process(arg);
-
     // Make sure category + color are consistent
     if (result.category.empty()) result.category = "routine";
     if (result.color == sf::Color()) result.color = sf::Color::Cyan;
@@ -238,7 +727,7 @@ CommandResult cmdSearchWeb(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_WEB_NO_ARGUMENT",
-            "No search query",
+            ResponseManager::voiceLine("no_search_query"),
             "error"
         };
     }
@@ -256,7 +745,7 @@ CommandResult cmdSearchWeb(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_WEB_OPEN_FAILED",
-            "Web search failed",
+            ResponseManager::voiceLine("web_search_failed"),
             "error"
         };
     }
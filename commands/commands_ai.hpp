@@ -9,7 +9,8 @@
  * @brief Show or change the active AI backend.
  * 
  * Usage:
- *   ai_backend             → shows current backend
+ *   ai_backend             → shows current backend + health
+ *   ai_backend refresh     → re-probes local backends now
  *   ai_backend <backend>   → sets backend (openai, ollama, localai, auto)
  */
 CommandResult cmdAiBackend(const std::string& arg);
@@ -22,6 +23,80 @@ CommandResult cmdAiBackend(const std::string& arg);
  */
 CommandResult cmdReloadNlp(const std::string& arg);
 
+/**
+ * @brief Show or clear the utterance → intent cache.
+ * 
+ * Usage:
+ *   intent_cache          → hit rate and time saved per stage
+ *   intent_cache clear    → drop all entries and counters
+ */
+CommandResult cmdIntentCache(const std::string& arg);
+
+/**
+ * @brief Show or clear the prompt → AI reply cache.
+ * 
+ * Usage:
+ *   ai_cache          → entries, hit rate, generation time saved
+ *   ai_cache clear    → drop all entries (and the saved file)
+ */
+CommandResult cmdAiCache(const std::string& arg);
+
+/**
+ * @brief Show or clear the multi-turn conversation context.
+ * 
+ * Usage:
+ *   ai_context          → transcript size, KV reuse, prompt eval cost
+ *   ai_context reset    → start a new conversation
+ */
+CommandResult cmdAiContext(const std::string& arg);
+
+/**
+ * @brief Show streaming AI metrics (time-to-first-token, totals).
+ * 
+ * Usage:
+ *   ai_stats [reset]
+ */
+CommandResult cmdAiStats(const std::string& arg);
+
+/**
+ * @brief Stream from a local stand-in server and compare
+ *        time-to-first-token against a buffered request.
+ * 
+ * Usage:
+ *   ai_stream_test [first_token_ms] [token_ms] [tokens]
+ */
+CommandResult cmdAiStreamTest(const std::string& arg);
+
+/**
+ * @brief Compare request latency with pooled keep-alive sessions
+ *        against a new connection per request (local stand-in).
+ * 
+ * Usage:
+ *   ai_http_bench [requests]
+ */
+CommandResult cmdAiHttpBench(const std::string& arg);
+
+/**
+ * @brief Replay overlapping voice turns against the local stand-in
+ *        and compare model-server generation time with and without
+ *        barge-in cancellation; then replay the mic while the reply
+ *        is audible and count replies cut off by their own echo.
+ * 
+ * Usage:
+ *   ai_bargein_bench [turns] [interrupt_ms]
+ */
+CommandResult cmdAiBargeInBench(const std::string& arg);
+
+/**
+ * @brief Drive callAIAsync, ai_process and ai_process_stream against
+ *        the local stand-in from concurrent clients and report
+ *        time-to-first-token, total latency and throughput.
+ * 
+ * Usage:
+ *   ai_bench [concurrency] [requests] [fail_percent]
+ */
+CommandResult cmdAiBench(const std::string& arg);
+
 /**
  * @brief General AI query (catch-all).
  * 
@@ -2,6 +2,7 @@
 #include "aliases.hpp"
 #include "console_history.hpp"
 #include "error_manager.hpp"
+#include "response_manager.hpp"
 
 // ------------------------------------------------------------
 // alias list → dump aliases by section
@@ -15,7 +16,7 @@ CommandResult cmdAliasList(const std::string& /*arg*/) {
             true,
             sf::Color::Yellow,
             "ERR_NONE",
-            "No aliases loaded",   // voice
+            ResponseManager::voiceLine("no_aliases_loaded"),   // voice
             "summary"
         };
     }
@@ -47,7 +48,7 @@ CommandResult cmdAliasList(const std::string& /*arg*/) {
         true,
         sf::Color::Cyan,
         "ERR_NONE",
-        "Aliases listed",   // short voice-friendly message
+        ResponseManager::voiceLine("aliases_listed"),   // short voice-friendly message
         "summary"
     };
 }
@@ -62,7 +63,7 @@ CommandResult cmdAliasInfo(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_ALIAS_NOT_FOUND",
-            "Alias name required",
+            ResponseManager::voiceLine("alias_name_required"),
             "error"
         };
     }
@@ -74,7 +75,7 @@ CommandResult cmdAliasInfo(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_ALIAS_NOT_FOUND",
-            "Alias not found",
+            ResponseManager::voiceLine("alias_not_found"),
             "error"
         };
     }
@@ -100,7 +101,7 @@ CommandResult cmdAliasRefresh(const std::string& /*arg*/) {
             true,
             sf::Color::Green,
             "ERR_NONE",
-            "Alias refresh complete",
+            ResponseManager::voiceLine("alias_refresh_complete"),
             "routine"
         };
     } catch (const std::exception& e) {
@@ -109,7 +110,7 @@ CommandResult cmdAliasRefresh(const std::string& /*arg*/) {
             false,
             sf::Color::Red,
             "ERR_ALIAS_NOT_FOUND",
-            "Alias refresh failed",
+            ResponseManager::voiceLine("alias_refresh_failed"),
             "error"
         };
     }
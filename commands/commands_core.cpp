@@ -10,12 +10,14 @@
 #include "response_manager.hpp"
 #include "console_history.hpp"
 #include "voice/voice_speak.hpp"
+#include "voice/voice_sentences.hpp"
 #include "error_manager.hpp"
 #include "resources.hpp"
 #include "nlp/nlp.hpp"
 #include "synonyms.hpp"
 #include "commands_core.hpp"
 #include "aliases.hpp"            // 🔹 alias resolution
+#include "nlp/intent_cache.hpp"   // 🔹 utterance → command cache
 
 using Voice::speak;
 
@@ -109,7 +111,15 @@ static void initCommands() {
         // --- AI / NLP ---
         {"ai_backend",   cmdAiBackend},
         {"reload_nlp",   cmdReloadNlp},
+        {"intent_cache", cmdIntentCache},
         {"grim_ai",      cmdGrimAi},   // ✅ catch-all AI queries
+        {"ai_stats",     cmdAiStats},
+        {"ai_cache",     cmdAiCache},
+        {"ai_context",   cmdAiContext},
+        {"ai_stream_test", cmdAiStreamTest},
+        {"ai_http_bench", cmdAiHttpBench},
+        {"ai_bargein_bench", cmdAiBargeInBench},
+        {"ai_bench",     cmdAiBench},
 
         // --- Filesystem ---
         {"pwd",          cmdShowPwd},
@@ -130,7 +140,12 @@ static void initCommands() {
         // --- Voice ---
         {"voice",        cmdVoice},
         {"voice_stream", cmdVoiceStream},
+        {"voice_calibrate", cmdVoiceCalibrate},
+        {"voice_stats",  cmdVoiceStats},
+        {"voice_bench",  cmdVoiceBench},
+        {"voice_profile", cmdVoiceProfile},
         {"test_tts",     cmd_testTTS},
+        {"tts_bench",    cmdTtsBench},
         {"test_sapi",    cmd_testSAPI},
         {"tts_device",   cmd_ttsDevice},
         {"list_voice",   cmd_listVoices},
@@ -187,6 +202,116 @@ CommandResult dispatchCommand(const std::string& cmd, const std::string& arg) {
     };
 }
 
+// ------------------------------------------------------------
+// resolveIntent: synonyms → NLP parse → slot fill → alias target
+// (the slow path; handleCommand caches its result per utterance)
+// ------------------------------------------------------------
+static IntentCache::Entry resolveIntent(const std::string& line,
+                                        const std::string& cmdRaw,
+                                        const std::string& argIn) {
+    std::cerr << "[TRACE][handleCommand] No direct match, running NLP parse...\n";
+    IntentCache::Entry entry;
+    std::string arg = argIn;
+    auto stageStart = std::chrono::steady_clock::now();
+    auto stageMs = [&stageStart] {
+        auto now = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(now - stageStart).count();
+        stageStart = now;
+        return ms;
+    };
+
+    // 🔹 Synonyms preprocessing
+    std::istringstream iss(line);
+    std::ostringstream oss;
+    std::string token;
+    while (iss >> token) {
+        oss << normalizeWord(token) << " ";
+    }
+    std::string normalizedLine = oss.str();
+    entry.normalizeMs = stageMs();
+
+    std::cerr << "[TRACE][handleCommand] Normalized line=\"" << normalizedLine << "\"\n";
+    Intent intent = g_nlp.parse(normalizedLine);
+    entry.parseMs = stageMs();
+
+    std::cerr << "[TRACE][handleCommand] NLP parse returned: "
+              << "name=\"" << intent.name << "\" "
+              << "matched=" << (intent.matched ? "true" : "false")
+              << " slots=" << intent.slots.size() << "\n";
+    for (const auto& [k, v] : intent.slots) {
+        std::cerr << "   slot[" << k << "]=\"" << v << "\"\n";
+    }
+
+    std::string cmd = intent.matched ? intent.name : normalizeCommand(cmdRaw);
+
+    // Fill arg from slots if present
+    if (intent.matched) {
+        std::string slotArg;
+        if (intent.slots.count("app") && !intent.slots.at("app").empty()) {
+            slotArg = intent.slots.at("app");
+        } else if (intent.slots.count("target") && !intent.slots.at("target").empty()) {
+            slotArg = intent.slots.at("target");
+        } else {
+            for (const auto& [k, v] : intent.slots) {
+                if (!v.empty()) { slotArg = v; break; }
+            }
+        }
+        if (!slotArg.empty()) {
+            arg = cleanArg(slotArg);   // 🔹 normalize punctuation, lowercase, trim
+        }
+    }
+
+    std::cerr << "[TRACE][handleCommand] Final dispatch values → cmd=\"" << cmd
+              << "\" arg=\"" << arg << "\"\n";
+    entry.parseMs += stageMs();
+
+    // Special case: open_app → resolve alias before dispatch
+    if (cmd == "open_app") {
+        arg = cleanArg(arg);
+        std::cerr << "[DEBUG][open_app] Cleaned arg=\"" << arg << "\"\n";
+
+        std::string resolved;
+        try {
+            resolved = aliases::resolve(arg);
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR][open_app] Exception during alias resolve: " << e.what() << "\n";
+            resolved.clear();
+        }
+
+        if (resolved.empty()) {
+            int bestDist = 3;
+            std::string bestAlias;
+
+            for (const auto& [alias, target] : aliases::getAll()) {
+                int dist = levenshteinDistance(normalizeWord(arg), normalizeWord(alias));
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    bestAlias = alias;
+                    resolved = target;
+                }
+            }
+
+            if (!resolved.empty()) {
+                std::cerr << "[DEBUG][open_app] Fuzzy matched \"" << arg
+                          << "\" → alias \"" << bestAlias
+                          << "\" → " << resolved << "\n";
+            }
+        }
+
+        if (resolved.empty()) {
+            std::cerr << "[DEBUG][open_app] No alias found, using raw name: " << arg << "\n";
+            resolved = arg;
+        }
+        entry.aliasMs = stageMs();
+        arg = resolved;
+    }
+
+    entry.intent = intent;
+    entry.cmd    = cmd;
+    entry.arg    = arg;
+    return entry;
+}
+
 // ------------------------------------------------------------
 // handleCommand: central hub for command + NLP execution
 // ------------------------------------------------------------
@@ -209,91 +334,22 @@ void handleCommand(const std::string& line) {
         result = dispatchCommand(cmdRaw, arg);
     }
     else {
-        // Case 2: NLP intent
-        std::cerr << "[TRACE][handleCommand] No direct match, running NLP parse...\n";
-
-        // 🔹 Synonyms preprocessing
-        std::istringstream iss(line);
-        std::ostringstream oss;
-        std::string token;
-        while (iss >> token) {
-            oss << normalizeWord(token) << " ";
-        }
-        std::string normalizedLine = oss.str();
-
-        std::cerr << "[TRACE][handleCommand] Normalized line=\"" << normalizedLine << "\"\n";
-        Intent intent = g_nlp.parse(normalizedLine);
-        g_lastIntent = intent;
-
-        std::cerr << "[TRACE][handleCommand] NLP parse returned: "
-                  << "name=\"" << intent.name << "\" "
-                  << "matched=" << (intent.matched ? "true" : "false")
-                  << " slots=" << intent.slots.size() << "\n";
-        for (const auto& [k, v] : intent.slots) {
-            std::cerr << "   slot[" << k << "]=\"" << v << "\"\n";
-        }
-
-        std::string cmd = intent.matched ? intent.name : normalizeCommand(cmdRaw);
-
-        // Fill arg from slots if present
-        if (intent.matched) {
-            std::string slotArg;
-            if (intent.slots.count("app") && !intent.slots.at("app").empty()) {
-                slotArg = intent.slots.at("app");
-            } else if (intent.slots.count("target") && !intent.slots.at("target").empty()) {
-                slotArg = intent.slots.at("target");
-            } else {
-                for (const auto& [k, v] : intent.slots) {
-                    if (!v.empty()) { slotArg = v; break; }
-                }
-            }
-            if (!slotArg.empty()) {
-                arg = cleanArg(slotArg);   // 🔹 normalize punctuation, lowercase, trim
-            }
+        // Case 2: NLP intent (cached per exact utterance)
+        std::string cacheKey = IntentCache::key(line);
+        IntentCache::Entry entry;
+
+        if (auto cached = IntentCache::lookup(cacheKey)) {
+            std::cerr << "[TRACE][handleCommand] Intent cache hit → cmd=\"" << cached->cmd
+                      << "\" arg=\"" << cached->arg << "\"\n";
+            entry = *cached;
+        } else {
+            entry = resolveIntent(line, cmdRaw, arg);
+            IntentCache::store(cacheKey, entry);
         }
+        g_lastIntent = entry.intent;
 
-        std::cerr << "[TRACE][handleCommand] Final dispatch values → cmd=\"" << cmd
-                  << "\" arg=\"" << arg << "\"\n";
-
-        // Special case: open_app → resolve alias before dispatch
-        if (cmd == "open_app") {
-            arg = cleanArg(arg);
-            std::cerr << "[DEBUG][open_app] Cleaned arg=\"" << arg << "\"\n";
-
-            std::string resolved;
-            try {
-                resolved = aliases::resolve(arg);
-            } catch (const std::exception& e) {
-                std::cerr << "[ERROR][open_app] Exception during alias resolve: " << e.what() << "\n";
-                resolved.clear();
-            }
-
-            if (resolved.empty()) {
-                int bestDist = 3;
-                std::string bestAlias;
-
-                for (const auto& [alias, target] : aliases::getAll()) {
-                    int dist = levenshteinDistance(normalizeWord(arg), normalizeWord(alias));
-                    if (dist < bestDist) {
-                        bestDist = dist;
-                        bestAlias = alias;
-                        resolved = target;
-                    }
-                }
-
-                if (!resolved.empty()) {
-                    std::cerr << "[DEBUG][open_app] Fuzzy matched \"" << arg
-                              << "\" → alias \"" << bestAlias
-                              << "\" → " << resolved << "\n";
-                }
-            }
-
-            if (resolved.empty()) {
-                std::cerr << "[DEBUG][open_app] No alias found, using raw name: " << arg << "\n";
-                resolved = arg;
-            }
-
-            result = dispatchCommand("open_app", resolved);
+        if (entry.cmd == "open_app") {
+            result = dispatchCommand("open_app", entry.arg);
         }
     }
 
@@ -313,9 +369,12 @@ void handleCommand(const std::string& line) {
     std::cout << finalText << std::endl;
 
     // ✅ Only speak real responses, never logs/traces
+    //    One item per sentence: the first one plays while the rest synthesize
     if (!result.voice.empty() && result.voice.find("[TRACE]") == std::string::npos) {
-        Voice::speak(result.voice,
-                     result.category.empty() ? "routine" : result.category);
+        for (const auto& sentence : Sentences::split(result.voice)) {
+            Voice::speak(sentence,
+                         result.category.empty() ? "routine" : result.category);
+        }
     }
 
     std::cerr << "[TRACE][handleCommand] END\n";
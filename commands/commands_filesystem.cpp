@@ -1,5 +1,6 @@
 #include "commands_filesystem.hpp"
 #include "console_history.hpp"
+#include "response_manager.hpp"
 
 extern ConsoleHistory history;
 extern std::filesystem::path g_currentDir;
@@ -13,7 +14,7 @@ CommandResult cmdShowPwd([[maybe_unused]] const std::string& arg) {
         true,
         sf::Color::Cyan,
         "ERR_NONE",
-        "Current directory shown",
+        ResponseManager::voiceLine("current_directory_shown"),
         "summary"
     };
 }
@@ -28,7 +29,7 @@ CommandResult cmdChangeDir(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_NO_ARGUMENT",
-            "Directory name required",
+            ResponseManager::voiceLine("directory_name_required"),
             "error"
         };
     }
@@ -40,7 +41,7 @@ CommandResult cmdChangeDir(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_NOT_FOUND",
-            "Directory not found",
+            ResponseManager::voiceLine("directory_not_found"),
             "error"
         };
     }
@@ -51,7 +52,7 @@ CommandResult cmdChangeDir(const std::string& arg) {
         true,
         sf::Color::Green,
         "ERR_NONE",
-        "Directory changed",
+        ResponseManager::voiceLine("directory_changed"),
         "routine"
     };
 }
@@ -70,7 +71,7 @@ CommandResult cmdListDir([[maybe_unused]] const std::string& arg) {
         true,
         sf::Color::Cyan,
         "ERR_NONE",
-        "Directory contents listed",
+        ResponseManager::voiceLine("directory_contents_listed"),
         "summary"
     };
 }
@@ -85,7 +86,7 @@ CommandResult cmdMakeDir(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_NO_ARGUMENT",
-            "Directory name required",
+            ResponseManager::voiceLine("directory_name_required"),
             "error"
         };
     }
@@ -97,7 +98,7 @@ CommandResult cmdMakeDir(const std::string& arg) {
             true,
             sf::Color::Green,
             "ERR_NONE",
-            "Directory created",
+            ResponseManager::voiceLine("directory_created"),
             "routine"
         };
     } else {
@@ -106,7 +107,7 @@ CommandResult cmdMakeDir(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_CREATE_FAILED",
-            "Failed to create directory",
+            ResponseManager::voiceLine("failed_to_create_directory"),
             "error"
         };
     }
@@ -122,7 +123,7 @@ CommandResult cmdRemoveFile(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_NO_ARGUMENT",
-            "File name required",
+            ResponseManager::voiceLine("file_name_required"),
             "error"
         };
     }
@@ -134,7 +135,7 @@ CommandResult cmdRemoveFile(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_NOT_FOUND",
-            "File not found",
+            ResponseManager::voiceLine("file_not_found"),
             "error"
         };
     }
@@ -145,7 +146,7 @@ CommandResult cmdRemoveFile(const std::string& arg) {
             true,
             sf::Color::Green,
             "ERR_NONE",
-            "File removed",
+            ResponseManager::voiceLine("file_removed"),
             "routine"
         };
     } else {
@@ -154,7 +155,7 @@ CommandResult cmdRemoveFile(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_FS_REMOVE_FAILED",
-            "Failed to remove file",
+            ResponseManager::voiceLine("failed_to_remove_file"),
             "error"
         };
     }
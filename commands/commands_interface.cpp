@@ -17,7 +17,7 @@ CommandResult cmdClean([[maybe_unused]] const std::string& arg) {
         true,
         sf::Color::Green,
         "ERR_NONE",
-        "Console cleared",   // voice
+        ResponseManager::voiceLine("console_cleared"),   // voice
         "routine"            // category
     };
 }
@@ -31,8 +31,16 @@ CommandResult cmdShowHelp([[maybe_unused]] const std::string& arg) {
         "- remember <key> <value>\n"
         "- recall <key>\n"
         "- forget <key>\n"
-        "- ai_backend <name>\n"
+        "- ai_backend [name|refresh]\n"
+        "- ai_stats [reset]\n"
+        "- ai_cache [clear]\n"
+        "- ai_context [reset]\n"
+        "- ai_stream_test [first_token_ms] [token_ms] [tokens]\n"
+        "- ai_http_bench [requests]\n"
+        "- ai_bargein_bench [turns] [interrupt_ms]\n"
+        "- ai_bench [concurrency] [requests] [fail_percent]\n"
         "- reloadnlp\n"
+        "- intent_cache [clear]\n"
         "- pwd\n"
         "- cd <dir>\n"
         "- ls\n"
@@ -43,14 +51,19 @@ CommandResult cmdShowHelp([[maybe_unused]] const std::string& arg) {
         "- clean\n"
         "- help\n"
         "- voice\n"
-        "- voice_stream\n";
+        "- voice_stream\n"
+        "- voice_calibrate [ms]\n"
+        "- voice_stats [reset]\n"
+        "- voice_bench [wav] [concurrency] [jobs] | profiles [dir] | audioctx [path]\n"
+        "- voice_profile [latency|balanced|accuracy]\n"
+        "- tts_bench [text]\n";
 
     return {
         helpText,
         true,
         sf::Color::Cyan,
         "ERR_NONE",
-        "Help shown",        // voice
+        ResponseManager::voiceLine("help_shown"),        // voice
         "summary"            // category
     };
 }
@@ -66,7 +79,7 @@ CommandResult cmd_reloadNLP([[maybe_unused]] const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_NLP_LOAD_FAILED",
-            "NLP reload failed",  // voice
+            ResponseManager::voiceLine("nlp_reload_failed"),  // voice
             "error"               // category
         };
     }
@@ -76,7 +89,7 @@ CommandResult cmd_reloadNLP([[maybe_unused]] const std::string& arg) {
         true,
         sf::Color::Yellow,
         "ERR_NONE",
-        "NLP rules reloaded",    // voice
+        ResponseManager::voiceLine("nlp_rules_reloaded"),    // voice
         "routine"                // category
     };
 }
\ No newline at end of file
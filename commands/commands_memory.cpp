@@ -19,7 +19,7 @@ CommandResult cmdRemember(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_MEMORY_MISSING_INPUT",
-            "Missing memory input",
+            ResponseManager::voiceLine("missing_memory_input"),
             "error"
         };
     }
@@ -32,7 +32,7 @@ CommandResult cmdRemember(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_MEMORY_BAD_FORMAT",
-            "Bad memory format",
+            ResponseManager::voiceLine("bad_memory_format"),
             "error"
         };
     }
@@ -62,7 +62,7 @@ CommandResult cmdRecall(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_MEMORY_MISSING_KEY",
-            "Missing memory key",
+            ResponseManager::voiceLine("missing_memory_key"),
             "error"
         };
     }
@@ -83,7 +83,7 @@ CommandResult cmdRecall(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_MEMORY_KEY_NOT_FOUND",
-            "Memory key not found",
+            ResponseManager::voiceLine("memory_key_not_found"),
             "error"
         };
     }
@@ -99,7 +99,7 @@ CommandResult cmdForget(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_MEMORY_MISSING_KEY",
-            "Missing memory key",
+            ResponseManager::voiceLine("missing_memory_key"),
             "error"
         };
     }
@@ -121,7 +121,7 @@ CommandResult cmdForget(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_MEMORY_KEY_NOT_FOUND",
-            "Memory key not found",
+            ResponseManager::voiceLine("memory_key_not_found"),
             "error"
         };
     }
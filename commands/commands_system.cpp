@@ -2,6 +2,7 @@
 #include "system_detect.hpp"
 #include "resources.hpp"       // 🔹 for history
 #include "error_manager.hpp"
+#include "response_manager.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <iostream>
@@ -38,7 +39,7 @@ CommandResult cmdSystemInfo([[maybe_unused]] const std::string& arg) {
         true,             // success flag
         sf::Color::Cyan,  // display color
         "ERR_NONE",       // no error
-        "System information shown", // voice
+        ResponseManager::voiceLine("system_information_shown"), // voice
         "summary"                  // category
     };
 }
@@ -18,7 +18,7 @@ CommandResult cmdSetTimer(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_TIMER_INVALID",
-            "Invalid timer duration",
+            ResponseManager::voiceLine("invalid_timer_duration"),
             "error"
         };
     }
@@ -29,7 +29,7 @@ CommandResult cmdSetTimer(const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_TIMER_NONPOSITIVE",
-            "Non-positive timer duration",
+            ResponseManager::voiceLine("non_positive_timer_duration"),
             "error"
         };
     }
@@ -46,7 +46,7 @@ CommandResult cmdSetTimer(const std::string& arg) {
         true,
         sf::Color::Green,
         "ERR_NONE",
-        "Timer set",
+        ResponseManager::voiceLine("timer_set"),
         "routine"
     };
 }
@@ -66,7 +66,7 @@ std::vector<CommandResult> checkExpiredTimers() {
                 true,
                 sf::Color::Yellow,
                 "ERR_NONE",
-                "Timer expired",
+                ResponseManager::voiceLine("timer_expired"),
                 "routine"
             });
             it = timers.erase(it);
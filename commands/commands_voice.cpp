@@ -28,8 +28,15 @@
 #include "error_manager.hpp"
 #include "voice/voice.hpp"
 #include "voice/voice_stream.hpp"
+#include "voice/voice_capture.hpp"
+#include "voice/whisper_pool.hpp"
+#include "voice/whisper_profiles.hpp"
+#include "voice/whisper_bench.hpp"
+#include "voice/whisper_constrained.hpp"
+#include "ai/ai_bargein.hpp"
 #include "commands_core.hpp"
 #include "voice/voice_speak.hpp"
+#include "voice/voice_tts_cache.hpp"
 #include "resources.hpp"
 #include "nlp/nlp.hpp"   // globals: history, timers, longTermMemory, g_nlp
 
@@ -85,7 +92,7 @@ CommandResult cmdVoice([[maybe_unused]] const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_VOICE_NO_SPEECH",
-            "No speech detected",
+            ResponseManager::voiceLine("no_speech_detected"),
             "error"
         };
     }
@@ -97,7 +104,7 @@ CommandResult cmdVoice([[maybe_unused]] const std::string& arg) {
         true,
         sf::Color::Cyan,
         "ERR_NONE",
-        "Voice command processed",
+        ResponseManager::voiceLine("voice_command_processed"),
         "routine"
     };
 }
@@ -106,24 +113,25 @@ CommandResult cmdVoice([[maybe_unused]] const std::string& arg) {
 // [Voice] Continuous streaming mode
 // ------------------------------------------------------------
 CommandResult cmdVoiceStream([[maybe_unused]] const std::string& arg) {
-    if (!Voice::g_state.ctx) {
+    // Awaits the bootstrap preload rather than requiring a prior `voice`
+    if (!WhisperPool::init(aiConfig)) {
         return {
             ErrorManager::getUserMessage("ERR_VOICE_NO_CONTEXT"),
             false,
             sf::Color::Red,
             "ERR_VOICE_NO_CONTEXT",
-            "Voice context missing",
+            ResponseManager::voiceLine("voice_context_missing"),
             "error"
         };
     }
 
-    if (VoiceStream::start(Voice::g_state.ctx, &history, timers, longTermMemory, g_nlp)) {
+    if (VoiceStream::start(WhisperPool::context(), &history, timers, longTermMemory, g_nlp)) {
         return {
             "[Voice] Streaming started.",
             true,
             sf::Color::Green,
             "ERR_NONE",
-            "Voice streaming started",
+            ResponseManager::voiceLine("voice_streaming_started"),
             "routine"
         };
     } else {
@@ -132,12 +140,298 @@ CommandResult cmdVoiceStream([[maybe_unused]] const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_VOICE_STREAM_FAIL",
-            "Voice streaming failed",
+            ResponseManager::voiceLine("voice_streaming_failed"),
             "error"
         };
     }
 }
 
+// ------------------------------------------------------------
+// [Voice] Streaming Whisper usage (VAD gating effectiveness)
+// ------------------------------------------------------------
+CommandResult cmdVoiceStats(const std::string& arg) {
+    if (arg == "reset") {
+        VoiceStream::resetStats();
+        BargeIn::resetStats();
+        Voice::resetTtsStats();
+        TtsCache::resetStats();
+        return { "[Voice] Stream stats reset.", true, sf::Color::Yellow,
+                 "ERR_NONE", "", "debug" };
+    }
+
+    VoiceStream::Stats st = VoiceStream::getStats();
+    double totalMin = (st.speechMs + st.idleMs) / 60000.0;
+    double idleMin  = st.idleMs / 60000.0;
+    double avgCpu   = st.whisperCalls ? st.whisperCpuMs / st.whisperCalls : 0.0;
+    double avgWall  = st.whisperCalls ? st.whisperWallMs / st.whisperCalls : 0.0;
+    double speechMin = st.speechMs / 60000.0;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[Voice] Stream stats\n";
+    oss << " - Audio       : " << st.speechMs / 1000.0 << " s speech, "
+        << st.idleMs / 1000.0 << " s idle (" << st.skippedBlocks << " blocks skipped)\n";
+    oss << " - Whisper     : " << st.whisperCalls << " calls, avg "
+        << avgWall << " ms wall / " << avgCpu << " ms process CPU\n";
+    oss << " - Worker      : max " << st.maxWhisperWallMs << " ms per call, avg wait "
+        << (st.jobsProcessed ? st.queueWaitMs / st.jobsProcessed : 0.0) << " ms\n";
+    oss << " - Queue       : depth " << st.queueDepth << " (max " << st.maxQueueDepth << "), "
+        << st.mergedJobs << " merged, "
+        << st.droppedSamples * 1000.0 / VoiceCapture::SAMPLE_RATE << " ms audio dropped\n";
+    if (totalMin > 0.0) {
+        oss << " - Per minute  : " << st.whisperCalls / totalMin << " calls, "
+            << st.whisperCpuMs / totalMin << " ms process CPU\n";
+    }
+    // Gated: Whisper runs measured while idle. Ungated: the same idle
+    // audio decoded at the rate measured on speech audio.
+    if (idleMin > 0.0 && speechMin > 0.0) {
+        oss << " - Idle minute : " << st.idleWhisperCalls / idleMin << " calls, "
+            << st.idleWhisperCpuMs / idleMin << " ms CPU gated vs ~"
+            << (st.whisperCalls - st.idleWhisperCalls) / speechMin << " calls, "
+            << (st.whisperCpuMs - st.idleWhisperCpuMs) / speechMin << " ms CPU at the speech rate\n";
+    }
+
+    if (st.speculativeDispatches + st.timeoutDispatches > 0) {
+        oss << " - Dispatch    : " << st.speculativeDispatches << " early (avg "
+            << (st.speculativeDispatches ? st.speculativeLatencyMs / st.speculativeDispatches : 0.0)
+            << " ms after speech), " << st.timeoutDispatches << " on timeout (avg "
+            << (st.timeoutDispatches ? st.timeoutLatencyMs / st.timeoutDispatches : 0.0)
+            << " ms), " << st.speculationsCancelled << "/" << st.speculationsArmed
+            << " speculations cancelled\n";
+    }
+
+    if (st.spokenReplies > 0) {
+        oss << " - Reply → TTS : " << st.spokenReplies << " replies, "
+            << st.sentencesSpoken << " sentences, first queued after avg "
+            << st.firstSentenceMs / st.spokenReplies << " ms vs "
+            << st.replyGenerationMs / st.spokenReplies << " ms to the last token\n";
+    }
+
+    Voice::TtsStats ts = Voice::getTtsStats();
+    if (ts.streamed + ts.fileBased > 0) {
+        oss << " - TTS         : " << ts.streamed << " streamed (first audio avg "
+            << (ts.streamed ? ts.streamFirstAudioMs / ts.streamed : 0.0) << " ms), "
+            << ts.fileBased << " via WAV file (avg "
+            << (ts.fileBased ? ts.fileFirstAudioMs / ts.fileBased : 0.0) << " ms), "
+            << ts.fallbacks << " fallbacks\n";
+    }
+    TtsCache::Stats cache = TtsCache::getStats();
+    if (ts.cached + cache.misses + ts.prewarmed > 0) {
+        oss << " - TTS cache   : " << ts.cached << " played from cache (first audio avg "
+            << (ts.cached ? ts.cachedFirstAudioMs / ts.cached : 0.0) << " ms), "
+            << cache.memoryHits << " memory / " << cache.diskHits << " disk hits, " << cache.misses
+            << " misses, " << ts.prewarmed << " pre-warmed; " << cache.memoryEntries << " in memory ("
+            << cache.memoryBytes / (1024.0 * 1024.0) << " MB), " << cache.diskEntries << " on disk ("
+            << cache.diskBytes / (1024.0 * 1024.0) << " MB), " << cache.evictions << " evicted\n";
+    }
+    if (ts.backToBack > 0) {
+        oss << " - TTS queue   : " << ts.backToBack << " items played back-to-back, avg gap "
+            << ts.gapMs / ts.backToBack << " ms\n";
+    }
+
+    BargeIn::Stats bs = BargeIn::getStats();
+    if (bs.interrupts + bs.superseded > 0) {
+        oss << " - Barge-in    : " << bs.interrupts << " interrupts (" << bs.replies
+            << " replies cancelled, " << bs.speechFlushed << " speech items cut), "
+            << bs.superseded << "/" << bs.turns << " turns superseded\n";
+    }
+
+    WhisperConstrained::Stats cs = WhisperConstrained::getStats();
+    if (cs.attempts > 0) {
+        oss << " - Constrained : " << cs.accepted << "/" << cs.attempts << " accepted, avg "
+            << cs.constrainedMs / cs.attempts << " ms, " << cs.fallbacks << " fallbacks (avg "
+            << (cs.fallbacks ? cs.fallbackMs / cs.fallbacks : 0.0) << " ms), vocab "
+            << cs.vocabWords << " words / " << cs.vocabTokens << " tokens\n";
+    }
+
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+// ------------------------------------------------------------
+// [Voice] Calibrate VAD noise floor (stay quiet while it runs)
+// ------------------------------------------------------------
+CommandResult cmdVoiceCalibrate(const std::string& arg) {
+    int durationMs = 2000;
+    if (!arg.empty()) {
+        try { durationMs = std::clamp(std::stoi(arg), 500, 10000); } catch (...) {}
+    }
+
+    float floor = VoiceStream::calibrateSilence(durationMs);
+    if (floor < 0.0f) {
+        return {
+            ErrorManager::getUserMessage("ERR_VOICE_NO_CONTEXT"),
+            false,
+            sf::Color::Red,
+            "ERR_VOICE_NO_CONTEXT",
+            ResponseManager::voiceLine("calibration_failed"),
+            "error"
+        };
+    }
+
+    std::ostringstream oss;
+    oss << "[Voice] Noise floor calibrated: RMS=" << floor;
+    return {
+        oss.str(),
+        true,
+        sf::Color::Green,
+        "ERR_NONE",
+        ResponseManager::voiceLine("microphone_calibrated"),
+        "routine"
+    };
+}
+
+// ------------------------------------------------------------
+// [Voice] Whisper benchmarks
+//   voice_bench [wav] [max_concurrency] [jobs]   pool concurrency
+//   voice_bench profiles [corpus_dir]            latency + WER
+//   voice_bench audioctx [wav|corpus_dir]        short vs full context
+// ------------------------------------------------------------
+static CommandResult benchAudioCtx(const std::string& path) {
+    auto results = WhisperBench::audioCtx(path);
+    if (results.empty()) {
+        return { "[Voice] No .wav clips found at " + path, false, sf::Color::Red,
+                 "ERR_AUDIO_LOAD", "", "error" };
+    }
+
+    double fullTotal = 0.0, shortTotal = 0.0;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[Voice] audio_ctx bench (" << WhisperProfiles::active() << " profile, best of 3)\n";
+    for (const auto& r : results) {
+        fullTotal  += r.fullMs;
+        shortTotal += r.shortMs;
+        oss << " - " << r.clip << " (" << r.audioSec << " s, ctx="
+            << (r.audioCtx > 0 ? std::to_string(r.audioCtx) : "full") << "): "
+            << r.fullMs << " → " << r.shortMs << " ms";
+        if (r.shortMs > 0.0) oss << " (" << r.fullMs / r.shortMs << "x)";
+        oss << ", WER " << r.fullWer * 100.0 << "% → " << r.shortWer * 100.0 << "%"
+            << (r.referenced ? "" : " vs full") << "\n";
+    }
+    if (shortTotal > 0.0) {
+        oss << " - Total: " << fullTotal << " → " << shortTotal << " ms ("
+            << fullTotal / shortTotal << "x faster)\n";
+    }
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+static CommandResult benchProfiles(const std::string& corpusDir) {
+    auto results = WhisperBench::profiles(corpusDir, WhisperProfiles::names());
+    if (results.empty()) {
+        return { "[Voice] No .wav clips found in " + corpusDir, false, sf::Color::Red,
+                 "ERR_AUDIO_LOAD", "", "error" };
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[Voice] Profile sweep: " << corpusDir << " (" << results.front().files
+        << " clips, " << results.front().audioSec << " s audio)\n";
+    for (const auto& r : results) {
+        oss << " - " << std::left << std::setw(9) << r.profile << std::right << ": "
+            << r.totalMs / r.files << " ms/clip avg, " << r.maxMs << " ms max, "
+            << (r.totalMs > 0.0 ? r.audioSec / (r.totalMs / 1000.0) : 0.0) << "x realtime, WER ";
+        if (r.wer < 0.0) oss << "n/a (no .txt references)";
+        else             oss << r.wer * 100.0 << "%";
+        oss << "\n";
+    }
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+static CommandResult benchConcurrency(const std::string& wavPath, int maxConcurrency, int jobs) {
+    std::vector<float> pcm;
+    if (!WhisperBench::loadPcm16k(wavPath, pcm)) {
+        return {
+            "[Voice] Failed to load " + wavPath,
+            false,
+            sf::Color::Red,
+            "ERR_AUDIO_LOAD",
+            ResponseManager::voiceLine("audio_load_failed"),
+            "error"
+        };
+    }
+
+    auto results = WhisperBench::concurrency(pcm, maxConcurrency, std::clamp(jobs, 1, 64));
+    if (results.empty()) {
+        return { "[Voice] Benchmark produced no results.", false, sf::Color::Red,
+                 "ERR_VOICE_TRANSCRIBE_FAIL", "", "error" };
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[Voice] Whisper pool bench: " << wavPath << " ("
+        << static_cast<double>(pcm.size()) / VoiceCapture::SAMPLE_RATE << " s audio, "
+        << results.front().jobs << " jobs/level, pool="
+        << WhisperPool::capacity() << ")\n";
+    for (const auto& r : results) {
+        oss << " - x" << r.concurrency << " (" << r.threadsPerJob << " thr/job): "
+            << r.wallMs << " ms wall, " << r.avgJobMs << " ms/job, "
+            << r.realtimeX << "x realtime";
+        if (r.concurrency > 1 && results.front().wallMs > 0.0) {
+            oss << ", speedup " << results.front().wallMs / r.wallMs << "x";
+        }
+        oss << "\n";
+    }
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
+CommandResult cmdVoiceBench(const std::string& arg) {
+    if (!WhisperPool::init(aiConfig)) {
+        return {
+            ErrorManager::getUserMessage("ERR_VOICE_NOT_INITIALIZED"),
+            false,
+            sf::Color::Red,
+            "ERR_VOICE_NOT_INITIALIZED",
+            ResponseManager::voiceLine("whisper_model_missing"),
+            "error"
+        };
+    }
+
+    std::istringstream iss(arg);
+    std::string first;
+    iss >> first;
+
+    if (first == "profiles") {
+        std::string dir;
+        iss >> dir;
+        if (dir.empty()) dir = getResourcePath() + "/voice_corpus";
+        return benchProfiles(dir);
+    }
+
+    if (first == "audioctx") {
+        std::string path;
+        iss >> path;
+        if (path.empty()) path = getResourcePath() + "/voice_corpus";
+        return benchAudioCtx(path);
+    }
+
+    int maxConcurrency = 4;
+    int jobs = 8;
+    iss >> maxConcurrency >> jobs;
+    if (first.empty()) first = getResourcePath() + "/test.wav";
+    return benchConcurrency(first, maxConcurrency, jobs);
+}
+
+// ------------------------------------------------------------
+// [Voice] Show / switch the Whisper decoding profile
+// ------------------------------------------------------------
+CommandResult cmdVoiceProfile(const std::string& arg) {
+    if (!arg.empty() && !WhisperProfiles::setActive(arg)) {
+        std::string list;
+        for (const auto& n : WhisperProfiles::names()) list += (list.empty() ? "" : ", ") + n;
+        return { "[Voice] Unknown profile '" + arg + "' (choose: " + list + ")",
+                 false, sf::Color::Red, "ERR_NONE", "", "error" };
+    }
+
+    WhisperProfiles::Profile p = WhisperProfiles::get();
+    std::ostringstream oss;
+    oss << "[Voice] Decoding profile: " << p.name
+        << " (" << (p.beam ? "beam " + std::to_string(p.beamSize) : "greedy")
+        << ", threads=" << (p.threads > 0 ? std::to_string(p.threads) : "auto")
+        << ", audio_ctx=" << (p.audioCtx > 0 ? std::to_string(p.audioCtx) : "full")
+        << ", max_tokens=" << p.maxTokens
+        << ", temp=" << p.temperature << "+" << p.temperatureInc << ")";
+    return { oss.str(), true, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
 // ------------------------------------------------------------
 // [Voice] Local TTS test (Microsoft David)
 // ------------------------------------------------------------
@@ -170,6 +464,38 @@ CommandResult cmd_testTTS([[maybe_unused]] const std::string& arg) {
     return result;
 }
 
+// ------------------------------------------------------------
+// [Voice] Time to first audio: streamed PCM vs WAV file
+// ------------------------------------------------------------
+CommandResult cmdTtsBench(const std::string& arg) {
+    std::string text = arg.empty()
+        ? "This is a longer test sentence for the speech engine. It has a second sentence, "
+          "so streaming can start playback before the whole reply is synthesized."
+        : arg;
+
+    if (!Voice::isReady()) {
+        return { "[Voice] TTS bridge is not running.", false, sf::Color::Red,
+                 "ERR_NONE", "", "error" };
+    }
+
+    Voice::TtsBench b = Voice::benchTTS(text);
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "[Voice] TTS bench (" << text.size() << " chars)\n";
+    oss << " - WAV file : ";
+    if (b.fileOk) oss << "first audio after " << b.fileFirstAudioMs << " ms\n";
+    else          oss << "failed\n";
+    oss << " - Streamed : ";
+    if (b.streamOk) {
+        oss << "first audio after " << b.streamFirstAudioMs << " ms, all PCM after "
+            << b.streamTotalMs << " ms (" << b.samples << " samples @ " << b.sampleRate << " Hz)\n";
+    } else {
+        oss << "not supported by the bridge\n";
+    }
+    return { oss.str(), b.fileOk || b.streamOk, sf::Color::Yellow, "ERR_NONE", "", "debug" };
+}
+
 // ------------------------------------------------------------
 // [Voice] List installed SAPI voices
 // ------------------------------------------------------------
@@ -190,7 +516,7 @@ CommandResult cmd_listVoices([[maybe_unused]] const std::string& arg) {
             true,
             sf::Color::Yellow,
             "ERR_NONE",
-            "Coqui voices listed",
+            ResponseManager::voiceLine("coqui_voices_listed"),
             "debug"
         };
     }
@@ -234,7 +560,7 @@ CommandResult cmd_listVoices([[maybe_unused]] const std::string& arg) {
             true,
             sf::Color::Yellow,
             "ERR_NONE",
-            "SAPI voices listed",
+            ResponseManager::voiceLine("sapi_voices_listed"),
             "debug"
         };
     }
@@ -246,7 +572,7 @@ CommandResult cmd_listVoices([[maybe_unused]] const std::string& arg) {
         false,
         sf::Color::Red,
         "ERR_TTS_ENUM",
-        "Failed to list SAPI voices",
+        ResponseManager::voiceLine("failed_to_list_sapi_voices"),
         "debug"
     };
 #else
@@ -255,7 +581,7 @@ CommandResult cmd_listVoices([[maybe_unused]] const std::string& arg) {
         false,
         sf::Color::Red,
         "ERR_UNSUPPORTED_PLATFORM",
-        "Voice listing unsupported",
+        ResponseManager::voiceLine("voice_listing_unsupported"),
         "debug"
     };
 #endif
@@ -272,7 +598,7 @@ CommandResult cmd_testSAPI([[maybe_unused]] const std::string& arg) {
             false,
             sf::Color::Red,
             "ERR_AUDIO_LOAD",
-            "Audio load failed",
+            ResponseManager::voiceLine("audio_load_failed"),
             "error"
         };
     }
@@ -291,7 +617,7 @@ CommandResult cmd_testSAPI([[maybe_unused]] const std::string& arg) {
         true,
         sf::Color::Green,
         "ERR_NONE",
-        "Audio playback succeeded",
+        ResponseManager::voiceLine("audio_playback_succeeded"),
         "routine"
     };
 }
@@ -4,7 +4,12 @@
 // Voice commands
 CommandResult cmdVoice(const std::string& arg);
 CommandResult cmdVoiceStream(const std::string& arg);
+CommandResult cmdVoiceCalibrate(const std::string& arg);
+CommandResult cmdVoiceStats(const std::string& arg);
+CommandResult cmdVoiceBench(const std::string& arg);
+CommandResult cmdVoiceProfile(const std::string& arg);
 CommandResult cmd_testTTS(const std::string& arg);
+CommandResult cmdTtsBench(const std::string& arg);
 CommandResult cmd_testSAPI(const std::string& arg);
 CommandResult cmd_ttsDevice(const std::string& arg);
 CommandResult cmd_listVoices(const std::string& arg);
@@ -17,6 +17,9 @@
 #include "wake/wake.hpp"
 #include "wake/wake_key.hpp"
 #include "wake/wake_voice.hpp"
+#include "ai/ai_backends.hpp"
+#include "ai/ai_executor.hpp"
+#include "ai/ai_response_cache.hpp"
 
 namespace fs = std::filesystem;
 
@@ -67,9 +70,12 @@ int main(int argc, char* argv[]) {
     }
 
     // 🔹 Startup greeting
-    Voice::speak("Welcome back, Austin. Grim is online.", "system");
+    Voice::speak(ResponseManager::get("greeting"), "system");
     LOG_PHASE("Startup greeting spoken", true);
 
+    // Phrases the commands speak render while idle so they play instantly later
+    Voice::prewarm(ResponseManager::phrases());
+
     LOG_PHASE("Startup complete, entering main loop", true);
 
     // ============================================================
@@ -115,6 +121,10 @@ int main(int argc, char* argv[]) {
     // ============================================================
     Voice::shutdownQueue();
     Voice::shutdownTTS();
+    Voice::shutdown();
+    AIExecutor::shutdown();
+    ResponseCache::save();
+    BackendRegistry::shutdown();
     LOG_PHASE("Shutdown complete", true);
 
     // 🔹 Close logger
@@ -0,0 +1,133 @@
+#include "intent_cache.hpp"
+#include "nlp.hpp"
+#include "synonyms.hpp"
+#include "aliases.hpp"
+#include "ai/ai.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace IntentCache {
+
+// ---------------- State ----------------
+using Versions = std::tuple<uint64_t, uint64_t, uint64_t>;   // rules, synonyms, aliases
+
+struct Node {
+    std::string key;
+    Entry       entry;
+};
+
+static std::mutex g_cacheMutex;
+static std::list<Node> g_lru;   // front = most recently used
+static std::unordered_map<std::string, std::list<Node>::iterator> g_index;
+static Versions g_versions{0, 0, 0};
+static Stats    g_stats;
+
+static size_t configuredCapacity(bool& enabled) {
+    enabled = true;
+    int capacity = 256;
+    if (aiConfig.is_object() && aiConfig.contains("intent_cache")) {
+        const auto& c = aiConfig["intent_cache"];
+        enabled  = c.value("enabled", enabled);
+        capacity = c.value("capacity", capacity);
+    }
+    return static_cast<size_t>(std::max(1, capacity));
+}
+
+static Versions currentVersions() {
+    return { g_nlp.rules_version(), synonymsVersion(), aliases::version() };
+}
+
+// Drop everything if rules, synonyms or aliases changed since the
+// entries were stored. Caller holds g_cacheMutex.
+static void validateLocked() {
+    Versions now = currentVersions();
+    if (now == g_versions) return;
+    if (!g_lru.empty()) g_stats.invalidations++;
+    g_lru.clear();
+    g_index.clear();
+    g_versions = now;
+}
+
+// ============================================================
+// Key
+// ============================================================
+// The exact line: resolveIntent parses the raw line, so folding case
+// or punctuation here would let two lines that parse differently
+// share an entry (case-sensitive rules, a "?" a pattern relies on).
+std::string key(const std::string& utterance) {
+    return utterance;
+}
+
+// ============================================================
+// Lookup / store
+// ============================================================
+std::optional<Entry> lookup(const std::string& k) {
+    bool enabled = true;
+    configuredCapacity(enabled);
+    if (!enabled || k.empty()) return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    validateLocked();
+    g_stats.lookups++;
+
+    auto it = g_index.find(k);
+    if (it == g_index.end()) return std::nullopt;
+
+    g_lru.splice(g_lru.begin(), g_lru, it->second);
+    const Entry& e = it->second->entry;
+    g_stats.hits++;
+    g_stats.savedNormalizeMs += e.normalizeMs;
+    g_stats.savedParseMs     += e.parseMs;
+    g_stats.savedAliasMs     += e.aliasMs;
+    return e;
+}
+
+void store(const std::string& k, const Entry& entry) {
+    bool enabled = true;
+    size_t capacity = configuredCapacity(enabled);
+    if (!enabled || k.empty()) return;
+
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    validateLocked();
+
+    auto it = g_index.find(k);
+    if (it != g_index.end()) {
+        it->second->entry = entry;
+        g_lru.splice(g_lru.begin(), g_lru, it->second);
+        return;
+    }
+
+    g_lru.push_front({ k, entry });
+    g_index[k] = g_lru.begin();
+
+    while (g_lru.size() > capacity) {
+        g_index.erase(g_lru.back().key);
+        g_lru.pop_back();
+        g_stats.evictions++;
+    }
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_lru.clear();
+    g_index.clear();
+    g_stats = Stats{};
+}
+
+Stats getStats() {
+    bool enabled = true;
+    size_t capacity = configuredCapacity(enabled);
+
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    Stats s = g_stats;
+    s.size     = g_lru.size();
+    s.capacity = enabled ? capacity : 0;
+    return s;
+}
+
+} // namespace IntentCache
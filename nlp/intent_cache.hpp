@@ -0,0 +1,48 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <optional>
+#include "intent.hpp"
+
+// ============================================================
+// IntentCache — utterance → resolved command (LRU)
+// ============================================================
+// - Keyed by the exact utterance, since that is what gets parsed.
+// - Stores the parsed intent, final command + argument and the
+//   alias target, so a repeat skips synonym normalization, the
+//   NLP regex scan and alias resolution.
+// - Every entry is dropped when NLP rules, synonyms or aliases
+//   report a new version.
+// ============================================================
+namespace IntentCache {
+    struct Entry {
+        Intent      intent;
+        std::string cmd;
+        std::string arg;       // after slot fill / alias resolution
+
+        // Time the miss spent in each stage (credited on every hit)
+        double normalizeMs = 0.0;
+        double parseMs     = 0.0;
+        double aliasMs     = 0.0;
+    };
+
+    struct Stats {
+        uint64_t lookups       = 0;
+        uint64_t hits          = 0;
+        uint64_t invalidations = 0;   // full clears after a version change
+        uint64_t evictions     = 0;
+        size_t   size          = 0;
+        size_t   capacity      = 0;
+        double   savedNormalizeMs = 0.0;
+        double   savedParseMs     = 0.0;
+        double   savedAliasMs     = 0.0;
+    };
+
+    std::string key(const std::string& utterance);
+
+    std::optional<Entry> lookup(const std::string& key);
+    void store(const std::string& key, const Entry& entry);
+    void clear();
+
+    Stats getStats();
+}
@@ -49,6 +49,7 @@ bool NLP::load_rules(const std::string& path, std::string* err) {
         f.close();
 
         rules.clear();
+        version++;
 
         for (auto& r : j) {
             Rule rule;
@@ -91,6 +92,7 @@ bool NLP::load_rules_from_string(const std::string& rulesText, std::string* err)
         nlohmann::json j = nlohmann::json::parse(rulesText);
 
         rules.clear();
+        version++;
 
         for (auto& r : j) {
             Rule rule;
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <regex>
 #include "intent.hpp"   // defines the Intent struct
 
@@ -29,8 +30,15 @@ public:
     // --- Debug helper ---
     size_t rule_count() const { return rules.size(); }
 
+    // --- Read-only access (vocabulary building) ---
+    const std::vector<Rule>& get_rules() const { return rules; }
+
+    // --- Bumped on every (re)load; caches compare against it ---
+    uint64_t rules_version() const { return version; }
+
 private:
     std::vector<Rule> rules;
+    uint64_t version = 0;
 };
 
 // 🔹 Global NLP object declaration (defined in nlp.cpp)
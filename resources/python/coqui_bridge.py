@@ -1,8 +1,14 @@
 import sys
 import json
+import struct
 import argparse
+import numpy as np
 from TTS.api import TTS
 import os
+import contextlib
+
+# PCM bytes per frame in speak_stream (~93 ms at 22.05 kHz mono)
+STREAM_CHUNK_BYTES = 4096
 
 # ---------- Helpers ----------
 def log(msg):
@@ -13,6 +19,58 @@ def send(obj):
     """Send JSON protocol messages to stdout."""
     print(json.dumps(obj), flush=True)
 
+def send_frame(data):
+    """Length-prefixed binary frame on stdout (empty frame = end)."""
+    out = sys.stdout.buffer
+    out.write(struct.pack("<I", len(data)))
+    out.write(data)
+    out.flush()
+
+def quiet():
+    """Coqui prints progress to stdout; keep it off the protocol stream."""
+    return contextlib.redirect_stdout(sys.stderr)
+
+def to_pcm16(wav):
+    samples = np.clip(np.asarray(wav, dtype=np.float32), -1.0, 1.0)
+    return (samples * 32767.0).astype("<i2").tobytes()
+
+def speak_stream(tts, text, speaker, speed):
+    """
+    Synthesize sentence by sentence and send PCM as each one is ready:
+      {"status": "stream", "sample_rate": N, "channels": 1, "format": "s16le"}
+      <uint32 LE length><bytes> ... <uint32 0>
+      {"status": "ok", "samples": N} | {"status": "error", ...}
+    """
+    try:
+        with quiet():
+            sentences = tts.synthesizer.split_into_sentences(text) or [text]
+    except Exception:
+        sentences = [text]
+
+    send({"status": "stream",
+          "sample_rate": tts.synthesizer.output_sample_rate,
+          "channels": 1,
+          "format": "s16le"})
+
+    total, error = 0, None
+    for sentence in sentences:
+        try:
+            with quiet():
+                wav = tts.tts(text=sentence, speaker=speaker, speed=speed)
+            pcm = to_pcm16(wav)
+        except Exception as e:
+            error = str(e)
+            break
+        for i in range(0, len(pcm), STREAM_CHUNK_BYTES):
+            send_frame(pcm[i:i + STREAM_CHUNK_BYTES])
+        total += len(pcm) // 2
+
+    send_frame(b"")
+    if error:
+        send({"status": "error", "message": error})
+    else:
+        send({"status": "ok", "samples": total})
+
 # ---------- Persistent Mode ----------
 def persistent_loop(model_name, speaker):
     try:
@@ -46,11 +104,16 @@ def persistent_loop(model_name, speaker):
                 out_path = req.get("out", "output.wav")
 
                 try:
-                    tts.tts_to_file(text=text, file_path=out_path,
-                                    speaker=spk, speed=speed)
+                    with quiet():
+                        tts.tts_to_file(text=text, file_path=out_path,
+                                        speaker=spk, speed=speed)
                     send({"status": "ok", "file": out_path})
                 except Exception as e:
                     send({"status": "error", "message": str(e)})
+            elif cmd == "speak_stream":
+                speak_stream(tts, req.get("text", ""),
+                             req.get("speaker", speaker),
+                             float(req.get("speed", 1.0)))
             else:
                 send({"status": "error", "message": f"Unknown command {cmd}"})
 
@@ -3,7 +3,9 @@
 #include "response_manager.hpp"
 #include "error_manager.hpp"
 #include "voice/voice_speak.hpp"
+#include "voice/voice_sentences.hpp"
 #include "console_history.hpp"
+#include "logger.hpp"
 
 CommandResult ResponseManager::systemMessage(const std::string& msg,
                                              const sf::Color& color) {
@@ -218,6 +220,9 @@ static std::unordered_map<std::string, std::vector<std::string>> responses = {
     }},
 
     // --- Startup ---
+    { "greeting", {
+        "Welcome back, Austin. Grim is online."
+    }},
     { "startup", {
         "GRIM is ready to go!",
         "All systems online.",
@@ -225,6 +230,89 @@ static std::unordered_map<std::string, std::vector<std::string>> responses = {
     }},
 };
 
+// Spoken `voice` lines of command results, by key. Commands take their
+// line from here (voiceLine), so the cache warms exactly what is said.
+static const std::unordered_map<std::string, std::string> voiceLines = {
+    // --- AI ---
+    { "current_ai_backend",          "Current AI backend" },
+    { "invalid_backend",             "Invalid backend" },
+    { "no_search_query",             "No search query" },
+    { "web_search_failed",           "Web search failed" },
+    { "failed_to_reload_nlp_rules",  "Failed to reload NLP rules" },
+
+    // --- Aliases ---
+    { "aliases_listed",              "Aliases listed" },
+    { "no_aliases_loaded",           "No aliases loaded" },
+    { "alias_name_required",         "Alias name required" },
+    { "alias_not_found",             "Alias not found" },
+    { "alias_refresh_complete",      "Alias refresh complete" },
+    { "alias_refresh_failed",        "Alias refresh failed" },
+
+    // --- Filesystem ---
+    { "current_directory_shown",     "Current directory shown" },
+    { "directory_changed",           "Directory changed" },
+    { "directory_contents_listed",   "Directory contents listed" },
+    { "directory_created",           "Directory created" },
+    { "directory_name_required",     "Directory name required" },
+    { "directory_not_found",         "Directory not found" },
+    { "failed_to_create_directory",  "Failed to create directory" },
+    { "file_removed",                "File removed" },
+    { "file_name_required",          "File name required" },
+    { "file_not_found",              "File not found" },
+    { "failed_to_remove_file",       "Failed to remove file" },
+
+    // --- Console / NLP ---
+    { "console_cleared",             "Console cleared" },
+    { "help_shown",                  "Help shown" },
+    { "nlp_rules_reloaded",          "NLP rules reloaded" },
+    { "nlp_reload_failed",           "NLP reload failed" },
+
+    // --- Memory ---
+    { "missing_memory_input",        "Missing memory input" },
+    { "missing_memory_key",          "Missing memory key" },
+    { "memory_key_not_found",        "Memory key not found" },
+    { "bad_memory_format",           "Bad memory format" },
+
+    // --- System / Timers ---
+    { "system_information_shown",    "System information shown" },
+    { "timer_set",                   "Timer set" },
+    { "timer_expired",               "Timer expired" },
+    { "invalid_timer_duration",      "Invalid timer duration" },
+    { "non_positive_timer_duration", "Non-positive timer duration" },
+
+    // --- Voice ---
+    { "voice_command_processed",     "Voice command processed" },
+    { "voice_streaming_started",     "Voice streaming started" },
+    { "voice_streaming_failed",      "Voice streaming failed" },
+    { "voice_context_missing",       "Voice context missing" },
+    { "whisper_model_missing",       "Whisper model missing" },
+    { "no_speech_detected",          "No speech detected" },
+    { "microphone_calibrated",       "Microphone calibrated" },
+    { "calibration_failed",          "Calibration failed" },
+    { "audio_playback_succeeded",    "Audio playback succeeded" },
+    { "audio_load_failed",           "Audio load failed" },
+    { "coqui_voices_listed",         "Coqui voices listed" },
+    { "sapi_voices_listed",          "SAPI voices listed" },
+    { "failed_to_list_sapi_voices",  "Failed to list SAPI voices" },
+    { "voice_listing_unsupported",   "Voice listing unsupported" },
+};
+
+std::string ResponseManager::voiceLine(const std::string& key) {
+    auto it = voiceLines.find(key);
+    if (it != voiceLines.end()) return it->second;
+    LOG_ERROR("ResponseManager", "Unknown voice line: " + key);
+    return "";
+}
+
+std::vector<std::string> ResponseManager::phrases() {
+    // The greeting is spoken whole; command texts one sentence at a time
+    std::vector<std::string> out = responses.at("greeting");
+    for (const auto& [key, text] : voiceLines) {
+        for (auto& sentence : Sentences::split(text)) out.push_back(std::move(sentence));
+    }
+    return out;
+}
+
 std::string ResponseManager::get(const std::string& keyOrMessage) {
     auto it = responses.find(keyOrMessage);
     if (it != responses.end() && !it->second.empty()) {
@@ -1,11 +1,20 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <SFML/Graphics/Color.hpp>
 #include "commands/commands_core.hpp"
 
 namespace ResponseManager {
     std::string get(const std::string& keyOrMessage);
 
+    // Spoken line for a command result's `voice` field (empty, and
+    // logged, for an unknown key)
+    std::string voiceLine(const std::string& key);
+
+    // The greeting and every voice line, split the way they are
+    // queued, for warming the TTS cache
+    std::vector<std::string> phrases();
+
     // System/log messages (bypass NLP/commands)
     CommandResult systemMessage(const std::string& msg,
                                 const sf::Color& color = sf::Color::Green);
@@ -12,12 +12,15 @@ std::unordered_map<std::string, std::vector<std::string>> g_synonyms;
 // Words that trigger transcript completion
 std::vector<std::string> g_completionTriggers;
 
+static std::atomic<uint64_t> g_synonymsVersion{0};
+
 
 // ---------------- Helpers ----------------
 static void loadFromJson(const nlohmann::json& j) {
     synonymMap.clear();
     g_synonyms.clear();
     g_completionTriggers.clear();
+    g_synonymsVersion++;
 
     for (auto& [key, value] : j.items()) {
         if (key == "completion_triggers") {
@@ -86,3 +89,7 @@ std::string normalizeWord(const std::string& input) {
     }
     return input; // return original if no match
 }
+
+uint64_t synonymsVersion() {
+    return g_synonymsVersion.load();
+}
@@ -2,6 +2,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
 
 // ---------------- Loaders ----------------
 
@@ -14,6 +15,9 @@ bool loadSynonymsFromString(const std::string& jsonStr);
 // Normalize a word to its canonical form (returns input if no match)
 std::string normalizeWord(const std::string& input);
 
+// Incremented on every load (lets caches detect a reload)
+uint64_t synonymsVersion();
+
 
 // ---------------- Globals ----------------
 
@@ -7,7 +7,7 @@ struct whisper_context;
 
 namespace Voice {
     struct State {
-        whisper_context* ctx = nullptr;
+        whisper_context* ctx = nullptr;   // shared weights (WhisperPool); decode via leases
         int minSpeechMs = 0;
         int minSilenceMs = 0;
         int inputDeviceIndex = -1;
@@ -0,0 +1,280 @@
+#include "voice_capture.hpp"
+#include "error_manager.hpp"
+#include "logger.hpp"
+
+#include <portaudio.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <algorithm>
+
+namespace VoiceCapture {
+
+// ---------------- State ----------------
+static std::mutex g_engineMutex;            // guards init/shutdown
+static bool       g_paInitialized = false;
+static PaStream*  g_stream        = nullptr;
+static int        g_deviceIndex   = paNoDevice;
+
+// Frames written by the PortAudio callback, drained by the dispatcher.
+// Single producer / single consumer ring: the callback never locks or
+// allocates. Indices only grow; the slot is index % RING_SIZE.
+static constexpr size_t RING_SIZE = 1 << 15;   // ~2 s at 16 kHz
+static float                g_ring[RING_SIZE];
+static std::atomic<size_t>  g_ringWrite{0};     // written by the callback
+static std::atomic<size_t>  g_ringRead{0};      // written by the dispatcher
+static std::atomic<size_t>  g_ringDropped{0};   // samples lost to a full ring
+
+static std::thread       g_dispatchThread;
+static std::atomic<bool> g_dispatchRunning{false};
+
+struct Subscriber {
+    std::string   name;
+    FrameCallback cb;
+};
+static std::mutex                g_subMutex;
+static std::map<int, Subscriber> g_subscribers;
+static int                       g_nextId = 0;
+
+// ============================================================
+// PortAudio callback (realtime thread: copy and return)
+// ============================================================
+static int captureCallback(const void* input,
+                           void* /*output*/,
+                           unsigned long frameCount,
+                           const PaStreamCallbackTimeInfo*,
+                           PaStreamCallbackFlags,
+                           void* /*userData*/) {
+    const float* in = static_cast<const float*>(input);
+    if (in) {
+        size_t write = g_ringWrite.load(std::memory_order_relaxed);
+        size_t read  = g_ringRead.load(std::memory_order_acquire);
+        size_t count = std::min<size_t>(frameCount, RING_SIZE - (write - read));
+        for (size_t i = 0; i < count; i++) {
+            g_ring[(write + i) % RING_SIZE] = in[i];
+        }
+        g_ringWrite.store(write + count, std::memory_order_release);
+        if (count < frameCount) {
+            g_ringDropped.fetch_add(frameCount - count, std::memory_order_relaxed);
+        }
+    }
+    return paContinue;
+}
+
+// ============================================================
+// Dispatcher: fan frames out to subscribers
+// ============================================================
+// Polls the ring: a wake-up from the callback would mean a syscall
+// on the realtime thread. 5 ms is well under one 32 ms buffer.
+static void dispatchLoop() {
+    std::vector<float> frames;
+    frames.reserve(RING_SIZE);
+    while (g_dispatchRunning) {
+        size_t read  = g_ringRead.load(std::memory_order_relaxed);
+        size_t write = g_ringWrite.load(std::memory_order_acquire);
+        if (write == read) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        for (size_t i = read; i != write; i++) {
+            frames.push_back(g_ring[i % RING_SIZE]);
+        }
+        g_ringRead.store(write, std::memory_order_release);
+
+        if (size_t dropped = g_ringDropped.exchange(0, std::memory_order_relaxed)) {
+            LOG_ERROR("VoiceCapture", "Dispatcher fell behind: dropped " +
+                                      std::to_string(dropped) + " samples");
+        }
+
+        std::lock_guard<std::mutex> lock(g_subMutex);
+        for (auto& [id, sub] : g_subscribers) {
+            try {
+                sub.cb(frames.data(), frames.size());
+            } catch (const std::exception& e) {
+                LOG_ERROR("VoiceCapture", "Subscriber '" + sub.name + "' threw: " + e.what());
+            }
+        }
+        frames.clear();
+    }
+}
+
+// ============================================================
+// Stream helpers (caller holds g_engineMutex)
+// ============================================================
+static void closeStreamLocked() {
+    if (g_stream) {
+        Pa_StopStream(g_stream);
+        Pa_CloseStream(g_stream);
+        g_stream = nullptr;
+    }
+    g_deviceIndex = paNoDevice;
+}
+
+static bool openStreamLocked(int requestedDevice) {
+    int deviceIndex = (requestedDevice >= 0) ? requestedDevice : Pa_GetDefaultInputDevice();
+    if (deviceIndex == paNoDevice || deviceIndex < 0 || deviceIndex >= Pa_GetDeviceCount()) {
+        LOG_ERROR("VoiceCapture", "No valid input device (requested=" +
+                                  std::to_string(requestedDevice) + ")");
+        return false;
+    }
+
+    const PaDeviceInfo* devInfo = Pa_GetDeviceInfo(deviceIndex);
+    if (!devInfo) {
+        LOG_ERROR("VoiceCapture", "No device info for index " + std::to_string(deviceIndex));
+        return false;
+    }
+
+    PaStreamParameters inputParams;
+    inputParams.device = deviceIndex;
+    inputParams.channelCount = 1;
+    inputParams.sampleFormat = paFloat32;
+    inputParams.suggestedLatency = devInfo->defaultLowInputLatency;
+    inputParams.hostApiSpecificStreamInfo = nullptr;
+
+    PaStream* stream = nullptr;
+    if (Pa_OpenStream(&stream, &inputParams, nullptr, SAMPLE_RATE, FRAMES_PER_BUFFER,
+                      paNoFlag, captureCallback, nullptr) != paNoError || !stream) {
+        LOG_ERROR("VoiceCapture", "Could not open mic stream on: " + std::string(devInfo->name));
+        return false;
+    }
+
+    if (Pa_StartStream(stream) != paNoError) {
+        LOG_ERROR("VoiceCapture", "Could not start mic stream on: " + std::string(devInfo->name));
+        Pa_CloseStream(stream);
+        return false;
+    }
+
+    g_stream = stream;
+    g_deviceIndex = deviceIndex;
+    LOG_DEBUG("VoiceCapture", "Capturing from: " + std::string(devInfo->name));
+    return true;
+}
+
+// ============================================================
+// Public API
+// ============================================================
+bool init(int deviceIndex) {
+    std::lock_guard<std::mutex> lock(g_engineMutex);
+
+    // Fast path: already capturing (-1 accepts whichever device is open)
+    if (g_stream) {
+        if (deviceIndex < 0 || deviceIndex == g_deviceIndex) return true;
+        LOG_DEBUG("VoiceCapture", "Switching input device → " + std::to_string(deviceIndex));
+        closeStreamLocked();
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    if (!g_paInitialized) {
+        if (Pa_Initialize() != paNoError) {
+            LOG_ERROR("VoiceCapture", "PortAudio init failed");
+            ErrorManager::report("ERR_VOICE_NO_CONTEXT");
+            return false;
+        }
+        g_paInitialized = true;
+    }
+
+    if (!openStreamLocked(deviceIndex)) {
+        ErrorManager::report("ERR_VOICE_NO_CONTEXT");
+        return false;
+    }
+
+    if (!g_dispatchRunning) {
+        g_dispatchRunning = true;
+        g_dispatchThread = std::thread(dispatchLoop);
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - t0).count();
+    LOG_DEBUG("VoiceCapture", "Engine ready in " + std::to_string(ms) + " ms");
+    LOG_PHASE("Voice capture init", true);
+    return true;
+}
+
+void shutdown() {
+    std::lock_guard<std::mutex> lock(g_engineMutex);
+
+    closeStreamLocked();
+
+    if (g_dispatchRunning) {
+        g_dispatchRunning = false;
+        if (g_dispatchThread.joinable()) g_dispatchThread.join();
+    }
+
+    // Neither end is running now: audio left in the ring must not
+    // reach the first subscriber after the next init()
+    g_ringRead    = 0;
+    g_ringWrite   = 0;
+    g_ringDropped = 0;
+
+    {
+        std::lock_guard<std::mutex> subLock(g_subMutex);
+        g_subscribers.clear();
+    }
+
+    if (g_paInitialized) {
+        Pa_Terminate();
+        g_paInitialized = false;
+        LOG_PHASE("Voice capture shutdown", true);
+    }
+}
+
+bool isRunning() {
+    std::lock_guard<std::mutex> lock(g_engineMutex);
+    return g_stream != nullptr;
+}
+
+int subscribe(const std::string& name, FrameCallback cb) {
+    if (!isRunning()) return -1;
+
+    std::lock_guard<std::mutex> lock(g_subMutex);
+    int id = g_nextId++;
+    g_subscribers[id] = Subscriber{name, std::move(cb)};
+    LOG_DEBUG("VoiceCapture", "Subscribed: " + name + " (id=" + std::to_string(id) + ")");
+    return id;
+}
+
+void unsubscribe(int id) {
+    std::lock_guard<std::mutex> lock(g_subMutex);
+    auto it = g_subscribers.find(id);
+    if (it != g_subscribers.end()) {
+        LOG_DEBUG("VoiceCapture", "Unsubscribed: " + it->second.name);
+        g_subscribers.erase(it);
+    }
+}
+
+// ============================================================
+// Buffer (pull-style subscriber)
+// ============================================================
+Buffer::Buffer(const std::string& name) {
+    id_ = subscribe(name, [this](const float* samples, size_t count) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            pending_.insert(pending_.end(), samples, samples + count);
+        }
+        cv_.notify_one();
+    });
+}
+
+Buffer::~Buffer() {
+    if (id_ >= 0) unsubscribe(id_);
+}
+
+bool Buffer::wait(std::vector<float>& out, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                      [this] { return !pending_.empty(); })) {
+        return false;
+    }
+    out.insert(out.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+    return true;
+}
+
+void Buffer::clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    pending_.clear();
+}
+
+} // namespace VoiceCapture
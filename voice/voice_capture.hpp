@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// ============================================================
+// VoiceCapture — single long-lived microphone engine
+// ============================================================
+// - Owns PortAudio for the whole process (Pa_Initialize once).
+// - Keeps one input stream open and fans frames out to
+//   subscribers (one-shot listen, continuous stream, wake).
+// - Subscriber callbacks run on the capture dispatch thread,
+//   never on the PortAudio realtime callback.
+// ============================================================
+namespace VoiceCapture {
+    constexpr int SAMPLE_RATE       = 16000;  // Whisper expects 16 kHz mono
+    constexpr int FRAMES_PER_BUFFER = 512;
+
+    // Receives mono float32 samples at SAMPLE_RATE.
+    using FrameCallback = std::function<void(const float* samples, size_t count)>;
+
+    // Start the engine on the given device (-1 = keep current / default input).
+    // Safe to call repeatedly; only reopens the stream if the device changes.
+    bool init(int deviceIndex = -1);
+    void shutdown();
+    bool isRunning();
+
+    // Returns a subscription id, or -1 if the engine is not running.
+    int  subscribe(const std::string& name, FrameCallback cb);
+    void unsubscribe(int id);
+
+    // --------------------------------------------------------
+    // Pull-style subscriber for loops that poll for audio.
+    // Unsubscribes automatically when destroyed.
+    // --------------------------------------------------------
+    class Buffer {
+    public:
+        explicit Buffer(const std::string& name);
+        ~Buffer();
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        bool valid() const { return id_ >= 0; }
+
+        // Wait up to timeoutMs for audio; moves everything buffered into out.
+        // Returns false if nothing arrived in time.
+        bool wait(std::vector<float>& out, int timeoutMs);
+        void clear();
+
+    private:
+        int id_ = -1;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::vector<float> pending_;
+    };
+}
@@ -0,0 +1,151 @@
+#include "voice_sentences.hpp"
+#include "ai/ai.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+
+namespace Sentences {
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("voice") &&
+        aiConfig["voice"].contains("sentences")) {
+        const auto& s = aiConfig["voice"]["sentences"];
+        opt.enabled  = s.value("enabled", opt.enabled);
+        opt.minChars = s.value("min_chars", opt.minChars);
+        opt.maxChars = s.value("max_chars", opt.maxChars);
+    }
+    opt.maxChars = std::max<size_t>(opt.maxChars, opt.minChars + 16);
+    return opt;
+}
+
+static std::string trim(const std::string& s) {
+    auto start = s.find_first_not_of(" \t\r\n");
+    auto end   = s.find_last_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    return s.substr(start, end - start + 1);
+}
+
+static bool isTerminator(char c) {
+    return c == '.' || c == '!' || c == '?';
+}
+
+static bool isCloser(char c) {
+    return c == '"' || c == '\'' || c == ')' || c == ']';
+}
+
+// ============================================================
+// Segmenter
+// ============================================================
+Segmenter::Segmenter(const Options& opt) : opt_(opt) {}
+
+bool Segmenter::abbreviationBefore(size_t i) const {
+    static const std::vector<std::string> kAbbreviations = {
+        "mr", "mrs", "ms", "dr", "prof", "st", "jr", "sr", "vs", "e.g", "i.e", "approx", "no"
+    };
+
+    size_t start = i;
+    while (start > 0 && (std::isalpha(static_cast<unsigned char>(buffer_[start - 1])) ||
+                         buffer_[start - 1] == '.')) {
+        start--;
+    }
+    std::string word = buffer_.substr(start, i - start);
+    if (word.empty()) return false;
+
+    // "J. R. R. Tolkien"
+    if (word.size() == 1 && std::isupper(static_cast<unsigned char>(word[0]))) return true;
+
+    std::transform(word.begin(), word.end(), word.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return std::find(kAbbreviations.begin(), kAbbreviations.end(), word) != kAbbreviations.end();
+}
+
+Segmenter::Cut Segmenter::boundaryAt(size_t i, size_t& end) const {
+    char c = buffer_[i];
+    if (c == '\n') {
+        end = i + 1;
+        return Cut::Yes;
+    }
+    if (!isTerminator(c)) return Cut::No;
+
+    // "?!", "..." and closing quotes stay with the sentence
+    size_t j = i + 1;
+    while (j < buffer_.size() && (isTerminator(buffer_[j]) || isCloser(buffer_[j]))) j++;
+    if (j == buffer_.size()) return Cut::Wait;   // "3." may still become "3.5"
+    if (!std::isspace(static_cast<unsigned char>(buffer_[j]))) return Cut::No;
+    if (c == '.' && j == i + 1 && abbreviationBefore(i)) return Cut::No;
+
+    end = j;
+    return Cut::Yes;
+}
+
+std::string Segmenter::take(size_t end) {
+    std::string sentence = trim(buffer_.substr(0, end));
+    buffer_.erase(0, end);
+    scan_ = 0;
+    return sentence;
+}
+
+std::vector<std::string> Segmenter::push(const std::string& chunk) {
+    std::vector<std::string> out;
+    buffer_ += chunk;
+
+    size_t i = scan_;
+    while (i < buffer_.size()) {
+        size_t end = 0;
+        Cut cut = boundaryAt(i, end);
+        if (cut == Cut::Wait) break;
+        if (cut == Cut::No) {
+            i++;
+            continue;
+        }
+        // Too short to speak alone: keep it for the next sentence
+        if (trim(buffer_.substr(0, end)).size() < opt_.minChars) {
+            i = end;
+            continue;
+        }
+        std::string sentence = take(end);
+        if (!sentence.empty()) out.push_back(std::move(sentence));
+        i = 0;
+    }
+    scan_ = std::min(i, buffer_.size());
+
+    // A run-on sentence: cut at the last pause that fits
+    while (buffer_.size() > opt_.maxChars) {
+        size_t cut = std::string::npos;
+        for (const char* pause : {", ", "; ", ": "}) {
+            size_t p = buffer_.rfind(pause, opt_.maxChars);
+            if (p != std::string::npos && p >= opt_.minChars &&
+                (cut == std::string::npos || p > cut)) {
+                cut = p;
+            }
+        }
+        if (cut == std::string::npos) {
+            size_t p = buffer_.rfind(' ', opt_.maxChars);
+            cut = (p != std::string::npos && p >= opt_.minChars) ? p : opt_.maxChars - 1;
+        }
+        std::string part = take(cut + 1);
+        if (!part.empty()) out.push_back(std::move(part));
+    }
+    return out;
+}
+
+std::string Segmenter::flush() {
+    return take(buffer_.size());
+}
+
+std::vector<std::string> split(const std::string& text, const Options& opt) {
+    if (!opt.enabled) {
+        std::string whole = trim(text);
+        if (whole.empty()) return {};
+        return { whole };
+    }
+    Segmenter segmenter(opt);
+    std::vector<std::string> out = segmenter.push(text);
+    std::string rest = segmenter.flush();
+    if (!rest.empty()) out.push_back(std::move(rest));
+    return out;
+}
+
+} // namespace Sentences
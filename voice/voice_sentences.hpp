@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// ============================================================
+// Sentences — split streamed AI text into speakable sentences
+// ============================================================
+// - Tokens are pushed as they arrive; every sentence that is
+//   complete comes back at once, in order, so it can be queued for
+//   TTS while the rest of the reply is still generating.
+// - A boundary is . ! ? or a newline followed by whitespace; a
+//   trailing "." waits for the next token. Common abbreviations
+//   ("Dr.", "e.g.") and initials do not end a sentence.
+// - Fragments shorter than minChars are joined with the next
+//   sentence; run-ons longer than maxChars are cut at a comma (or
+//   a space) so the first audio is never held back for long.
+// - Tuned by ai_config.json "voice" → "sentences".
+// ============================================================
+namespace Sentences {
+    struct Options {
+        bool   enabled  = true;   // false: speak replies only once complete
+        size_t minChars = 12;
+        size_t maxChars = 220;
+    };
+    Options loadOptions();
+
+    class Segmenter {
+    public:
+        explicit Segmenter(const Options& opt = loadOptions());
+
+        // Append a chunk; returns the sentences it completed
+        std::vector<std::string> push(const std::string& chunk);
+
+        // Whatever is left once the text has ended (may be empty)
+        std::string flush();
+
+    private:
+        enum class Cut { No, Wait, Yes };
+        Cut boundaryAt(size_t i, size_t& end) const;
+        bool abbreviationBefore(size_t i) const;
+        std::string take(size_t end);
+
+        Options     opt_;
+        std::string buffer_;
+        size_t      scan_ = 0;   // buffer_ before this has no boundary
+    };
+
+    // Whole text at once (same rules as Segmenter)
+    std::vector<std::string> split(const std::string& text, const Options& opt = loadOptions());
+}
@@ -1,4 +1,5 @@
 #include "voice_speak.hpp"
+#include "voice_tts_cache.hpp"
 #include "logger.hpp"
 #include "popup_ui/popup_ui.hpp" 
 
@@ -9,9 +10,13 @@
 #include <random>
 #include <fstream>
 #include <unordered_map>
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
 #ifdef _WIN32
@@ -28,16 +33,135 @@ namespace Voice {
     static std::vector<std::unique_ptr<sf::SoundBuffer>> activeBuffers;
     static std::vector<std::unique_ptr<sf::Sound>> activeSounds;
 
+    // PCM played while it is still being produced. The synthesis
+    // stage fills it; the playback stage plays it and waits on it.
+    class PcmStream : public sf::SoundStream {
+    public:
+        // stop() detaches the stream from the audio device, whose
+        // callback may be inside onGetData
+        ~PcmStream() override {
+            interrupt();
+            stop();
+        }
+
+        // Before the first push (bridge header or WAV file)
+        void open(unsigned channels, unsigned sampleRate) {
+            channels = std::clamp(channels, 1u, 2u);
+            initialize(channels, sampleRate,
+                       channels == 1 ? std::vector<sf::SoundChannel>{sf::SoundChannel::Mono}
+                                     : std::vector<sf::SoundChannel>{sf::SoundChannel::FrontLeft,
+                                                                     sf::SoundChannel::FrontRight});
+            std::lock_guard<std::mutex> lock(mutex_);
+            channels_   = channels;
+            sampleRate_ = sampleRate;
+        }
+
+        void push(std::vector<std::int16_t> samples) {
+            if (samples.empty()) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (interrupted_) return;
+                pending_.push_back(std::move(samples));
+                hasData_ = true;
+            }
+            cv_.notify_all();
+        }
+
+        // No more data: playback ends once the queue is drained
+        void finish() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                finished_ = true;
+            }
+            cv_.notify_all();
+        }
+
+        // Barge-in / shutdown: drop what is left and wake every wait
+        void interrupt() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                interrupted_ = true;
+                finished_    = true;
+                pending_.clear();
+            }
+            cv_.notify_all();
+        }
+
+        // Until the first chunk exists; false if none ever will
+        bool waitForData() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return hasData_ || finished_; });
+            return hasData_ && !interrupted_;
+        }
+
+        // Until everything handed to SFML has been heard, or interrupt()
+        void waitDone() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return ended_ || interrupted_; });
+            if (interrupted_ || sampleRate_ == 0) return;
+
+            // The device still holds the last buffers (a fraction of a second)
+            double total = static_cast<double>(handedOut_) / (sampleRate_ * channels_);
+            lock.unlock();
+            if (getStatus() != sf::SoundSource::Status::Playing) return;
+            double tail = std::min(0.5, total - getPlayingOffset().asSeconds());
+            lock.lock();
+            if (tail > 0.0) {
+                cv_.wait_for(lock, std::chrono::duration<double>(tail), [this] { return interrupted_; });
+            }
+        }
+
+    protected:
+        // Runs on the audio device callback: never waits
+        bool onGetData(Chunk& data) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Synthesis fell behind: a little silence, never a stalled device
+            if (pending_.empty() && !finished_) {
+                current_.assign(std::max(1u, sampleRate_ * channels_ / 50), 0);   // 20 ms
+            } else if (pending_.empty()) {
+                ended_ = true;
+                cv_.notify_all();
+                return false;
+            } else {
+                current_ = std::move(pending_.front());
+                pending_.pop_front();
+            }
+            handedOut_      += current_.size();
+            data.samples     = current_.data();
+            data.sampleCount = current_.size();
+            return true;
+        }
+        void onSeek(sf::Time) override {}
+
+    private:
+        std::mutex                            mutex_;
+        std::condition_variable               cv_;
+        std::deque<std::vector<std::int16_t>> pending_;
+        std::vector<std::int16_t>             current_;   // read by SFML until the next call
+        unsigned channels_    = 1;
+        unsigned sampleRate_  = 0;
+        uint64_t handedOut_   = 0;      // samples given to SFML
+        bool     hasData_     = false;
+        bool     finished_    = false;  // producer is done
+        bool     ended_       = false;  // onGetData ran dry after finish()
+        bool     interrupted_ = false;
+    };
+
     static std::string g_engine     = "coqui";
     static std::string g_speaker    = "p225";
     static double      g_speed      = 1.0;
     static fs::path    g_outputDir  = "D:/G.R.I.M/resources/tts_out";
+    static std::atomic<bool> g_streamPcm{true};   // off once the bridge says it cannot
     static std::unordered_map<std::string, std::string> g_rules;
 
+    static std::mutex  g_ttsStatsMutex;
+    static TtsStats    g_ttsStats;
+
     // =========================================================
     // Bridge state
     // =========================================================
     static bool g_ttsReady = false;
+    static std::mutex bridgeMutex;   // one request on the pipe at a time
 
 #ifdef _WIN32
     static HANDLE hChildStdinWr = nullptr;
@@ -48,11 +172,34 @@ namespace Voice {
     // =========================================================
     // Queue state
     // =========================================================
-    static std::queue<std::pair<std::string,std::string>> speakQueue;
+    // Two stages: synthThread renders up to g_lookAhead items ahead
+    // while playThread plays them in order, so item N+1 is ready (or
+    // already streaming) when item N finishes.
+    struct SpeakItem {
+        std::string text;
+        std::string category;
+        AIExecutor::CancelToken token;
+    };
+    // From synthesis start until played
+    struct Rendered {
+        SpeakItem   item;
+        std::string engine;
+        std::shared_ptr<PcmStream> stream;   // coqui only
+    };
+    static std::deque<SpeakItem> speakQueue;                  // not started
+    static std::deque<std::shared_ptr<Rendered>> readyQueue;  // rendering / rendered
+    static std::deque<std::string> prewarmQueue;              // cache only, when idle
+    static std::shared_ptr<Rendered> nowPlaying;
+    static size_t g_lookAhead = 2;
+    // Pre-warming waits this long after the last real speech
+    static constexpr auto PREWARM_IDLE = std::chrono::milliseconds(2000);
+    static std::chrono::steady_clock::time_point g_lastSpeechAt;   // queued or finished playing
     static std::mutex queueMutex;
-    static std::condition_variable queueCV;
+    static std::condition_variable queueCV;   // synthesis stage
+    static std::condition_variable playCV;    // playback stage
     static bool workerRunning = false;
-    static std::thread workerThread;
+    static std::thread synthThread;
+    static std::thread playThread;
 
     // =========================================================
     // Helpers
@@ -87,7 +234,21 @@ namespace Voice {
         for (const auto& s : activeSounds) {
             if (s && s->getStatus() == sf::SoundSource::Status::Playing) return true;
         }
-        return false;
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return nowPlaying && nowPlaying->stream &&
+               nowPlaying->stream->getStatus() == sf::SoundSource::Status::Playing;
+    }
+
+    bool isSpeaking() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!speakQueue.empty() || !readyQueue.empty() || nowPlaying) return true;
+        }
+        return isPlaying();
+    }
+
+    static double msSince(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
     }
 
 #ifdef _WIN32
@@ -134,8 +295,326 @@ namespace Voice {
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
     }
+
+    // Blocking read of exactly n bytes (binary PCM frames)
+    static bool readExactFromBridge(void* out, size_t n) {
+        auto* p = static_cast<char*>(out);
+        while (n > 0) {
+            DWORD read = 0;
+            if (!ReadFile(hChildStdoutRd, p, static_cast<DWORD>(n), &read, nullptr) || read == 0) {
+                LOG_ERROR("Voice/Bridge", "ReadFile failed while streaming");
+                return false;
+            }
+            p += read;
+            n -= read;
+        }
+        return true;
+    }
+
+    static bool writeToBridge(const std::string& line) {
+        DWORD written = 0;
+        BOOL ok = WriteFile(hChildStdinWr, line.c_str(), (DWORD)line.size(), &written, nullptr);
+        LOG_DEBUG("Voice/Coqui", "Sent request (" + std::to_string(written) + " bytes): " + line);
+        if (!ok) LOG_ERROR("Voice/Coqui", "WriteFile failed");
+        return ok;
+    }
+#endif
+
+#ifdef _WIN32
+    // =========================================================
+    // Bridge process
+    // =========================================================
+    // Spawn the bridge and wait for its "ready" line
+    static bool startBridge() {
+        SECURITY_ATTRIBUTES saAttr{};
+        saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
+        saAttr.bInheritHandle = TRUE;
+        saAttr.lpSecurityDescriptor = nullptr;
+
+        HANDLE hChildStdinRdTmp = nullptr, hChildStdoutWrTmp = nullptr;
+        CreatePipe(&hChildStdinRdTmp, &hChildStdinWr, &saAttr, 0);
+        SetHandleInformation(hChildStdinWr, HANDLE_FLAG_INHERIT, 0);
+        CreatePipe(&hChildStdoutRd, &hChildStdoutWrTmp, &saAttr, 0);
+        SetHandleInformation(hChildStdoutRd, HANDLE_FLAG_INHERIT, 0);
+
+        STARTUPINFOA si{};
+        ZeroMemory(&si, sizeof(si));
+        si.cb = sizeof(STARTUPINFOA);
+        si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+        si.hStdOutput = hChildStdoutWrTmp;
+        si.hStdInput  = hChildStdinRdTmp;
+        si.dwFlags |= STARTF_USESTDHANDLES;
+
+        std::string cmd = "\"C:/Program Files/Python310/python.exe\" -u D:/G.R.I.M/resources/python/coqui_bridge.py --persistent";
+        std::vector<char> mutableCmd(cmd.begin(), cmd.end());
+        mutableCmd.push_back('\0');
+
+        ZeroMemory(&piProcInfo, sizeof(piProcInfo));
+        CreateProcessA(nullptr, mutableCmd.data(), nullptr, nullptr, TRUE, 0,
+                       nullptr, "D:/G.R.I.M/resources/python", &si, &piProcInfo);
+
+        CloseHandle(hChildStdoutWrTmp);
+        CloseHandle(hChildStdinRdTmp);
+
+        std::string response = readJsonLineFromBridge();
+        try {
+            auto resp = json::parse(response);
+            if (resp.value("status", "") == "ready") {
+                LOG_PHASE("Voice bridge ready", true);
+                return true;
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Voice/Init", std::string("Parsing handshake failed: ") + e.what() +
+                                     " raw=" + response);
+        }
+        return false;
+    }
+
+    // Kill the bridge and close its pipes. Caller holds bridgeMutex.
+    static void stopBridge() {
+        if (piProcInfo.hProcess) {
+            TerminateProcess(piProcInfo.hProcess, 1);
+            WaitForSingleObject(piProcInfo.hProcess, 2000);
+            CloseHandle(piProcInfo.hProcess);
+            CloseHandle(piProcInfo.hThread);
+        }
+        if (hChildStdinWr)  CloseHandle(hChildStdinWr);
+        if (hChildStdoutRd) CloseHandle(hChildStdoutRd);
+        hChildStdinWr = hChildStdoutRd = nullptr;
+        ZeroMemory(&piProcInfo, sizeof(piProcInfo));
+    }
+
+    // A PCM frame length above this means the pipe is out of step
+    static constexpr std::uint32_t MAX_FRAME_BYTES = 1u << 20;
+
+    // The pipe is out of step: start over. Caller holds bridgeMutex.
+    static void restartBridge(const std::string& why) {
+        LOG_ERROR("Voice/Coqui", "Bridge stream broken (" + why + "); restarting bridge");
+        stopBridge();
+        g_ttsReady = startBridge();
+    }
 #endif
 
+    // =========================================================
+    // Streaming synthesis (bridge "speak_stream")
+    // =========================================================
+    // Header line, then <uint32 LE length><s16le PCM> frames up to an
+    // empty frame, then a status line. onFormat(sampleRate, channels)
+    // comes first; onPcm receives every frame. Frames are always read
+    // to the end so the pipe stays in step, even if the caller stopped
+    // caring; a short read or a bad length restarts the bridge, since
+    // the pipe can no longer be trusted. Returns false if nothing was
+    // streamed (use the file path) or the stream broke; *complete is set
+    // once the whole phrase arrived without an error.
+    using FormatFn = std::function<void(unsigned sampleRate, unsigned channels)>;
+    using PcmFn    = std::function<void(std::vector<std::int16_t>&& samples)>;
+
+    static bool coquiStream([[maybe_unused]] const std::string& text,
+                            [[maybe_unused]] const std::string& speaker,
+                            [[maybe_unused]] double speed,
+                            [[maybe_unused]] const FormatFn& onFormat,
+                            [[maybe_unused]] const PcmFn& onPcm,
+                            bool* complete = nullptr) {
+        if (complete) *complete = false;
+#ifdef _WIN32
+        std::lock_guard<std::mutex> lock(bridgeMutex);
+        if (!hChildStdinWr || !hChildStdoutRd) {
+            LOG_ERROR("Voice/Coqui", "Bridge not running");
+            return false;
+        }
+
+        json req = {
+            {"command", "speak_stream"},
+            {"text", text},
+            {"speaker", speaker},
+            {"speed", speed}
+        };
+        if (!writeToBridge(req.dump() + "\n")) return false;
+
+        std::string header = readJsonLineFromBridge();
+        auto h = json::parse(header, nullptr, false);
+        if (h.is_discarded() || h.value("status", "") != "stream") {
+            // Older bridge: stop asking
+            if (!h.is_discarded() && h.value("message", "").rfind("Unknown command", 0) == 0) {
+                LOG_DEBUG("Voice/Coqui", "Bridge has no speak_stream; using WAV files");
+                g_streamPcm = false;
+            } else {
+                LOG_ERROR("Voice/Coqui", "Stream refused: " + header);
+            }
+            return false;
+        }
+        if (onFormat) onFormat(h.value("sample_rate", 22050u), h.value("channels", 1u));
+
+        while (true) {
+            std::uint32_t bytes = 0;
+            if (!readExactFromBridge(&bytes, sizeof(bytes))) {
+                restartBridge("short read on a frame length");
+                return false;
+            }
+            if (bytes == 0) break;
+            if (bytes > MAX_FRAME_BYTES || bytes % sizeof(std::int16_t) != 0) {
+                restartBridge("bad frame length " + std::to_string(bytes));
+                return false;
+            }
+
+            std::vector<std::int16_t> samples(bytes / sizeof(std::int16_t));
+            if (!readExactFromBridge(samples.data(), bytes)) {
+                restartBridge("short read inside a frame");
+                return false;
+            }
+            if (onPcm) onPcm(std::move(samples));
+        }
+
+        std::string status = readJsonLineFromBridge();
+        if (status.find("\"error\"") != std::string::npos) {
+            LOG_ERROR("Voice/Coqui", "Stream ended with error: " + status);
+        } else if (complete) {
+            *complete = true;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Read a WAV written by the bridge into clip, then delete it
+    static bool loadWav(const std::string& wavPath, TtsCache::Clip& clip) {
+        if (wavPath.empty()) return false;
+        sf::SoundBuffer buffer;
+        bool ok = buffer.loadFromFile(wavPath);
+        if (ok) {
+            clip.sampleRate = buffer.getSampleRate();
+            clip.channels   = buffer.getChannelCount();
+            clip.samples.assign(buffer.getSamples(), buffer.getSamples() + buffer.getSampleCount());
+        }
+        std::error_code ec;
+        fs::remove(wavPath, ec);
+        return ok;
+    }
+
+    // Whole clip into a stream, in 100 ms chunks
+    static void pushClip(PcmStream& stream, const TtsCache::Clip& clip) {
+        stream.open(clip.channels, clip.sampleRate);
+        const std::int16_t* samples = clip.samples.data();
+        size_t count = clip.samples.size();
+        size_t chunk = std::max<size_t>(1, clip.sampleRate * clip.channels / 10);
+        for (size_t i = 0; i < count; i += chunk) {
+            stream.push(std::vector<std::int16_t>(samples + i, samples + std::min(count, i + chunk)));
+        }
+    }
+
+    // Fill r.stream: from the phrase cache, else PCM from the bridge
+    // as it is synthesized, else via a WAV file. Complete renderings
+    // go into the cache. Runs on the synthesis stage.
+    static void synthesize(Rendered& r) {
+        const auto& token = r.item.token;
+        auto t0 = std::chrono::steady_clock::now();
+
+        TtsCache::Key cacheKey = TtsCache::key(r.item.text, r.engine, g_speaker, g_speed);
+        if (auto cached = TtsCache::find(cacheKey)) {
+            pushClip(*r.stream, *cached);
+            r.stream->finish();
+            std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+            g_ttsStats.cached++;
+            g_ttsStats.cachedFirstAudioMs += msSince(t0);
+            return;
+        }
+
+        TtsCache::Clip clip;   // copy of what was rendered, for the cache
+        bool gotAudio = false;
+        bool complete = false;
+
+        bool tried = g_streamPcm;
+        if (tried) {
+            coquiStream(r.item.text, g_speaker, g_speed,
+                [&](unsigned sampleRate, unsigned channels) {
+                    r.stream->open(channels, sampleRate);
+                    clip.sampleRate = sampleRate;
+                    clip.channels   = channels;
+                },
+                [&](std::vector<std::int16_t>&& samples) {
+                    // Interrupted: keep draining the pipe, render nothing more
+                    if (token.cancelled()) return;
+                    if (!gotAudio) {
+                        gotAudio = true;
+                        std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+                        g_ttsStats.streamed++;
+                        g_ttsStats.streamFirstAudioMs += msSince(t0);
+                    }
+                    if (cacheKey) clip.samples.insert(clip.samples.end(), samples.begin(), samples.end());
+                    r.stream->push(std::move(samples));
+                },
+                &complete);
+        }
+
+        // Failed before any audio: the file path tries
+        if (!gotAudio && !token.cancelled()) {
+            if (tried) {
+                std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+                g_ttsStats.fallbacks++;
+            }
+            complete = loadWav(coquiSpeak(r.item.text, g_speaker, g_speed), clip) && !token.cancelled();
+            if (complete) {
+                pushClip(*r.stream, clip);
+                std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+                g_ttsStats.fileBased++;
+                g_ttsStats.fileFirstAudioMs += msSince(t0);
+            }
+        }
+        r.stream->finish();
+
+        // An interrupted rendering would replay cut short
+        if (complete && !token.cancelled()) TtsCache::store(cacheKey, std::move(clip));
+    }
+
+    static bool speechPending() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return !speakQueue.empty();
+    }
+
+    // Real speech arrived: put the phrase back for the next idle spell
+    static void yieldPrewarm(const std::string& text) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (workerRunning) prewarmQueue.push_front(text);
+    }
+
+    // Render a phrase into the cache without playing it. Gives way to
+    // real speech between bridge calls; a rendering already under way
+    // is drained (the pipe must be) but discarded.
+    static void prewarmPhrase(const std::string& text) {
+        TtsCache::Key cacheKey = TtsCache::key(text, "coqui", g_speaker, g_speed);
+        if (!cacheKey || TtsCache::contains(cacheKey)) return;
+
+        TtsCache::Clip clip;
+        bool complete = false;
+        bool yielded  = false;
+        if (g_streamPcm) {
+            coquiStream(text, g_speaker, g_speed,
+                [&](unsigned sampleRate, unsigned channels) {
+                    clip.sampleRate = sampleRate;
+                    clip.channels   = channels;
+                },
+                [&](std::vector<std::int16_t>&& samples) {
+                    if (yielded || (yielded = speechPending())) return;
+                    clip.samples.insert(clip.samples.end(), samples.begin(), samples.end());
+                },
+                &complete);
+        }
+        if (yielded || (!complete && speechPending())) {
+            yieldPrewarm(text);
+            return;
+        }
+        if (!complete) {
+            clip = TtsCache::Clip{};
+            complete = loadWav(coquiSpeak(text, g_speaker, g_speed), clip);
+        }
+        if (!complete) return;
+
+        TtsCache::store(cacheKey, std::move(clip));
+        std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+        g_ttsStats.prewarmed++;
+    }
+
     // =========================================================
     // Init / Shutdown
     // =========================================================
@@ -152,6 +631,8 @@ namespace Voice {
                     if (v.contains("speaker"))     g_speaker   = v["speaker"].get<std::string>();
                     if (v.contains("speed"))       g_speed     = v["speed"].get<double>();
                     if (v.contains("output_dir"))  g_outputDir = v["output_dir"].get<std::string>();
+                    if (v.contains("stream_pcm"))  g_streamPcm = v["stream_pcm"].get<bool>();
+                    if (v.contains("look_ahead"))  g_lookAhead = std::max(1, v["look_ahead"].get<int>());
                 }
             }
         } catch (const std::exception& e) {
@@ -159,49 +640,7 @@ namespace Voice {
         }
 
 #ifdef _WIN32
-        if (g_engine == "coqui") {
-            SECURITY_ATTRIBUTES saAttr{};
-            saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
-            saAttr.bInheritHandle = TRUE;
-            saAttr.lpSecurityDescriptor = nullptr;
-
-            HANDLE hChildStdinRdTmp = nullptr, hChildStdoutWrTmp = nullptr;
-            CreatePipe(&hChildStdinRdTmp, &hChildStdinWr, &saAttr, 0);
-            SetHandleInformation(hChildStdinWr, HANDLE_FLAG_INHERIT, 0);
-            CreatePipe(&hChildStdoutRd, &hChildStdoutWrTmp, &saAttr, 0);
-            SetHandleInformation(hChildStdoutRd, HANDLE_FLAG_INHERIT, 0);
-
-            STARTUPINFOA si{};
-            ZeroMemory(&si, sizeof(si));
-            si.cb = sizeof(STARTUPINFOA);
-            si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
-            si.hStdOutput = hChildStdoutWrTmp;
-            si.hStdInput  = hChildStdinRdTmp;
-            si.dwFlags |= STARTF_USESTDHANDLES;
-
-            std::string cmd = "\"C:/Program Files/Python310/python.exe\" -u D:/G.R.I.M/resources/python/coqui_bridge.py --persistent";
-            std::vector<char> mutableCmd(cmd.begin(), cmd.end());
-            mutableCmd.push_back('\0');
-
-            ZeroMemory(&piProcInfo, sizeof(piProcInfo));
-            CreateProcessA(nullptr, mutableCmd.data(), nullptr, nullptr, TRUE, 0,
-                           nullptr, "D:/G.R.I.M/resources/python", &si, &piProcInfo);
-
-            CloseHandle(hChildStdoutWrTmp);
-            CloseHandle(hChildStdinRdTmp);
-
-            std::string response = readJsonLineFromBridge();
-            try {
-                auto resp = json::parse(response);
-                if (resp.value("status", "") == "ready") {
-                    g_ttsReady = true;
-                    LOG_PHASE("Voice bridge ready", true);
-                }
-            } catch (const std::exception& e) {
-                LOG_ERROR("Voice/Init", std::string("Parsing handshake failed: ") + e.what() +
-                                         " raw=" + response);
-            }
-        }
+        if (g_engine == "coqui") g_ttsReady = startBridge();
 #endif
         return true;
     }
@@ -224,64 +663,136 @@ namespace Voice {
     }
 
     // =========================================================
-    // Queue worker
+    // Queue workers
     // =========================================================
-    static void speakWorker() {
+    static std::string engineFor(const std::string& category) {
+        auto it = g_rules.find(category);
+        if (it != g_rules.end() && (it->second == "coqui" || it->second == "sapi")) {
+            return it->second;
+        }
+        return "coqui";
+    }
+
+    // Stage 1: start rendering the next item while the look-ahead has room
+    static void synthWorker() {
         while (true) {
             std::unique_lock<std::mutex> lock(queueMutex);
-            queueCV.wait(lock, [] { return !speakQueue.empty() || !workerRunning; });
+            // Pre-warm only once nothing has been said or played for a while
+            auto idle = [] {
+                return speakQueue.empty() && readyQueue.empty() && !nowPlaying &&
+                       std::chrono::steady_clock::now() - g_lastSpeechAt >= PREWARM_IDLE;
+            };
+            while (workerRunning &&
+                   !(readyQueue.size() < g_lookAhead && !speakQueue.empty()) &&
+                   !(!prewarmQueue.empty() && idle())) {
+                bool busy = !speakQueue.empty() || !readyQueue.empty() || nowPlaying;
+                if (prewarmQueue.empty() || busy) queueCV.wait(lock);
+                else queueCV.wait_until(lock, g_lastSpeechAt + PREWARM_IDLE);
+            }
             if (!workerRunning) break;
 
-            auto [text, category] = speakQueue.front();
-            speakQueue.pop();
+            // Nothing to say: fill the cache
+            if (speakQueue.empty()) {
+                std::string text = std::move(prewarmQueue.front());
+                prewarmQueue.pop_front();
+                lock.unlock();
+                if (g_ttsReady) prewarmPhrase(text);
+                continue;
+            }
+
+            SpeakItem item = std::move(speakQueue.front());
+            speakQueue.pop_front();
+            if (item.token.cancelled()) continue;
+
+            auto r = std::make_shared<Rendered>();
+            r->engine = engineFor(item.category);
+            r->item   = std::move(item);
+            if (r->engine == "coqui") r->stream = std::make_shared<PcmStream>();
+
+            // Queued before rendering: playback can start with the first chunk
+            readyQueue.push_back(r);
             lock.unlock();
+            playCV.notify_one();
 
-            LOG_DEBUG("Voice/Worker", "Processing: " + text);
+            LOG_DEBUG("Voice/Worker", "Synthesizing: " + r->item.text);
+            if (r->stream) synthesize(*r);
+        }
+    }
 
-            std::string engine = "coqui";
-            auto it = g_rules.find(category);
-            if (it != g_rules.end()) {
-                if (it->second == "coqui" || it->second == "sapi")
-                    engine = it->second;
-            }
+    // Stage 2: play rendered items in order
+    static void playWorker() {
+        auto lastEnd = std::chrono::steady_clock::now();
+        bool followOn = false;   // next item was already queued when the last one ended
 
-            if (engine == "coqui") {
-                std::string wavPath = coquiSpeak(text, g_speaker, g_speed);
-                if (!wavPath.empty()) {
-                    playAudio(wavPath);
-                    while (isPlaying()) {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        while (true) {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            playCV.wait(lock, [] { return !readyQueue.empty() || !workerRunning; });
+            if (!workerRunning) break;
+
+            std::shared_ptr<Rendered> r = readyQueue.front();
+            readyQueue.pop_front();
+            queueCV.notify_one();   // room in the look-ahead
+            if (r->item.token.cancelled()) continue;
+            nowPlaying = r;
+            lock.unlock();
+
+            LOG_DEBUG("Voice/Worker", "Playing: " + r->item.text);
+
+            if (r->stream) {
+                if (r->stream->waitForData() && !r->item.token.cancelled()) {
+                    if (followOn) {
+                        std::lock_guard<std::mutex> statsLock(g_ttsStatsMutex);
+                        g_ttsStats.backToBack++;
+                        g_ttsStats.gapMs += msSince(lastEnd);
                     }
+                    notifyPopupActivity();
+                    r->stream->play();
+                    r->stream->waitDone();
                 }
+                r->stream->stop();
             }
 #ifdef _WIN32
-            else if (engine == "sapi") {
+            else if (r->engine == "sapi") {
                 std::string command = "powershell -Command "
                     "\"Add-Type -AssemblyName System.Speech; "
                     "(New-Object System.Speech.Synthesis.SpeechSynthesizer)"
                     ".Speak([Console]::In.ReadToEnd())\"";
                 FILE* pipe = _popen(command.c_str(), "w");
                 if (pipe) {
-                    fwrite(text.c_str(), 1, text.size(), pipe);
+                    fwrite(r->item.text.c_str(), 1, r->item.text.size(), pipe);
                     _pclose(pipe);
                 }
             }
 #endif
+            lock.lock();
+            nowPlaying.reset();
+            followOn = !readyQueue.empty() || !speakQueue.empty();
+            lastEnd  = std::chrono::steady_clock::now();
+            g_lastSpeechAt = lastEnd;
+            queueCV.notify_one();   // pre-warming may resume once idle
         }
     }
 
     void initQueue() {
         workerRunning = true;
-        workerThread = std::thread(speakWorker);
+        synthThread = std::thread(synthWorker);
+        playThread  = std::thread(playWorker);
     }
 
     void shutdownQueue() {
         {
             std::lock_guard<std::mutex> lock(queueMutex);
             workerRunning = false;
+            prewarmQueue.clear();
+            for (auto& r : readyQueue) {
+                if (r->stream) r->stream->interrupt();
+            }
+            if (nowPlaying && nowPlaying->stream) nowPlaying->stream->interrupt();
         }
         queueCV.notify_all();
-        if (workerThread.joinable()) workerThread.join();
+        playCV.notify_all();
+        if (synthThread.joinable()) synthThread.join();
+        if (playThread.joinable()) playThread.join();
     }
 
     // =========================================================
@@ -341,14 +852,9 @@ namespace Voice {
             {"speed", speed},
             {"out", outFile}
         };
-        std::string line = req.dump() + "\n";
 
-        DWORD written = 0;
-        BOOL ok = WriteFile(hChildStdinWr, line.c_str(), (DWORD)line.size(), &written, nullptr);
-        LOG_DEBUG("Voice/Coqui", "Sent request (" + std::to_string(written) + " bytes): " + line);
-        if (!ok) {
-            LOG_ERROR("Voice/Coqui", "WriteFile failed");
-        }
+        std::lock_guard<std::mutex> lock(bridgeMutex);
+        writeToBridge(req.dump() + "\n");
 
         std::string response = readJsonLineFromBridge();
         LOG_DEBUG("Voice/Coqui", "Got response: " + response);
@@ -367,14 +873,107 @@ namespace Voice {
         return "";
     }
 
+    // =========================================================
+    // Time to first audio
+    // =========================================================
+    TtsStats getTtsStats() {
+        std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+        return g_ttsStats;
+    }
+
+    void resetTtsStats() {
+        std::lock_guard<std::mutex> lock(g_ttsStatsMutex);
+        g_ttsStats = TtsStats{};
+    }
+
+    TtsBench benchTTS(const std::string& text) {
+        TtsBench bench;
+
+        // File: synthesize everything, write, read back
+        auto t0 = std::chrono::steady_clock::now();
+        std::string wavPath = coquiSpeak(text, g_speaker, g_speed);
+        if (!wavPath.empty()) {
+            sf::SoundBuffer buffer;
+            bench.fileOk = buffer.loadFromFile(wavPath);
+            bench.fileFirstAudioMs = msSince(t0);
+            std::error_code ec;
+            fs::remove(wavPath, ec);
+        }
+
+        // Stream: first chunk is playable
+        t0 = std::chrono::steady_clock::now();
+        bench.streamOk = coquiStream(text, g_speaker, g_speed,
+            [&](unsigned sampleRate, unsigned) { bench.sampleRate = sampleRate; },
+            [&](std::vector<std::int16_t>&& samples) {
+                if (bench.samples == 0) bench.streamFirstAudioMs = msSince(t0);
+                bench.samples += samples.size();
+            });
+        bench.streamTotalMs = msSince(t0);
+        bench.streamOk = bench.streamOk && bench.samples > 0;
+        return bench;
+    }
+
     // =========================================================
     // High-level Speak (enqueue)
     // =========================================================
-    void speak(const std::string& text, const std::string& category) {
+    void speak(const std::string& text, const std::string& category,
+               const AIExecutor::CancelToken& token) {
         {
             std::lock_guard<std::mutex> lock(queueMutex);
-            speakQueue.emplace(text, category);
+            speakQueue.push_back({text, category, token});
+            g_lastSpeechAt = std::chrono::steady_clock::now();
+        }
+        queueCV.notify_one();
+    }
+
+    void prewarm(const std::vector<std::string>& phrases) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            prewarmQueue.insert(prewarmQueue.end(), phrases.begin(), phrases.end());
+        }
+        LOG_DEBUG("Voice/Cache", "Pre-warming " + std::to_string(phrases.size()) + " phrases");
+        queueCV.notify_one();
+    }
+
+    // Caller holds queueMutex
+    static void stopRendered(Rendered& r) {
+        r.item.token.cancel();
+        if (r.stream) r.stream->interrupt();
+    }
+
+    size_t cancelSpeech() {
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            count = speakQueue.size() + readyQueue.size();
+            speakQueue.clear();
+            for (auto& r : readyQueue) stopRendered(*r);
+            readyQueue.clear();
+            if (nowPlaying && !nowPlaying->item.token.cancelled()) {
+                stopRendered(*nowPlaying);
+                count++;
+            }
+        }
+        queueCV.notify_one();
+        return count;
+    }
+
+    size_t cancelSpeech(const AIExecutor::CancelToken& token) {
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            count += std::erase_if(speakQueue, [&](const SpeakItem& i) { return i.token == token; });
+            count += std::erase_if(readyQueue, [&](const std::shared_ptr<Rendered>& r) {
+                if (!(r->item.token == token)) return false;
+                stopRendered(*r);
+                return true;
+            });
+            if (nowPlaying && nowPlaying->item.token == token) {
+                stopRendered(*nowPlaying);
+                count++;
+            }
         }
         queueCV.notify_one();
+        return count;
     }
 }
@@ -1,20 +1,71 @@
 #pragma once
 #include <string>
+#include <vector>
+#include "ai/ai_executor.hpp"
 
 namespace Voice {
     bool initTTS();
     void shutdownTTS();
     bool isReady();
     bool isPlaying();
+    // Speech queued, rendering or playing (the mic may hear it soon)
+    bool isSpeaking();
 
     // Queue management
     void initQueue();
     void shutdownQueue();
 
-    // Speech
-    void speak(const std::string& text, const std::string& category);
+    // Render phrases into the TTS cache (voice_tts_cache.hpp) once
+    // nothing has been spoken for a while; real speech goes first and
+    // already cached ones are skipped
+    void prewarm(const std::vector<std::string>& phrases);
+
+    // Speech. Cancelling the token drops the item if still queued
+    // and stops it if it is playing.
+    void speak(const std::string& text, const std::string& category,
+               const AIExecutor::CancelToken& token = AIExecutor::CancelToken{});
+
+    // Drop everything queued and stop what is playing (barge-in).
+    // Returns the number of items dropped or stopped.
+    size_t cancelSpeech();
+    // Same, for the items of one token only (a superseded turn)
+    size_t cancelSpeech(const AIExecutor::CancelToken& token);
+    // Synthesize to a WAV file; returns its path ("" on failure)
     std::string coquiSpeak(const std::string& text,
                            const std::string& speaker,
                            double speed);
     void playAudio(const std::string& path);
+
+    // Coqui items are normally streamed: the bridge sends PCM over
+    // its pipe sentence by sentence and playback starts with the
+    // first chunk. The next item is synthesized while one plays
+    // (voice.look_ahead items ahead). coquiSpeak + playAudio remain the fallback for
+    // bridges without "speak_stream" (voice.stream_pcm = false).
+    // Short phrases heard before skip the bridge: see TtsCache.
+    struct TtsStats {
+        uint64_t streamed           = 0;
+        uint64_t fileBased          = 0;
+        uint64_t fallbacks          = 0;     // stream refused, file used
+        uint64_t cached             = 0;     // played from the phrase cache
+        uint64_t prewarmed          = 0;     // rendered into the cache at startup
+        double   streamFirstAudioMs = 0.0;   // summed synthesis start → first playable PCM
+        double   fileFirstAudioMs   = 0.0;
+        double   cachedFirstAudioMs = 0.0;
+        uint64_t backToBack         = 0;     // items that followed one already playing
+        double   gapMs              = 0.0;   // summed silence between those
+    };
+    TtsStats getTtsStats();
+    void     resetTtsStats();
+
+    // Synthesize text both ways without playing it
+    struct TtsBench {
+        bool     fileOk             = false;
+        bool     streamOk           = false;
+        double   fileFirstAudioMs   = 0.0;   // file written and loaded
+        double   streamFirstAudioMs = 0.0;   // first PCM chunk received
+        double   streamTotalMs      = 0.0;
+        size_t   samples            = 0;
+        unsigned sampleRate         = 0;
+    };
+    TtsBench benchTTS(const std::string& text);
 }
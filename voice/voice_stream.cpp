@@ -3,55 +3,78 @@
 #include "ui_helpers.hpp"
 #include "commands/commands_core.hpp"
 #include "ai/ai.hpp"
+#include "ai/ai_bargein.hpp"
 #include "nlp/nlp.hpp"
 #include "synonyms.hpp"
 #include "resources.hpp"
 #include "voice.hpp"
 #include "logger.hpp"
+#include "voice_capture.hpp"
+#include "voice_vad.hpp"
+#include "voice_stream_decoder.hpp"
+#include "voice_sentences.hpp"
+#include "voice_speak.hpp"
+#include "whisper_pool.hpp"
+#include "whisper_constrained.hpp"
 
 #include <whisper.h>
-#include <portaudio.h>
 #include <filesystem>
 #include <mutex>
 #include <thread>
+#include <atomic>
+#include <deque>
+#include <condition_variable>
 #include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <cmath>
+#include <ctime>
 
 namespace fs = std::filesystem;
 
 // ---------------- Config (from ai_config.json via ai.cpp) ----------------
-extern double g_silenceThreshold;
 extern int g_silenceTimeoutMs;
-extern std::string g_whisperLanguage;
-extern int g_whisperMaxTokens;
 
 // ---------------- State ----------------
 VoiceStream::State VoiceStream::g_state;
 
-// Minimum buffer before calling Whisper (~100ms at 16kHz)
-constexpr size_t MIN_SAMPLES = 1600;
-
-// PCM accumulator for incremental mode
-static std::vector<float> pcmAccumulator;
-
-// ---------------- Silence Detection ----------------
-static bool isSilence(const std::vector<float>& pcm) {
-    if (pcm.empty()) return true;
-
-    double energy = 0.0;
-    for (float s : pcm) energy += s * s;
-    energy /= pcm.size();
-
-    double rms = std::sqrt(energy);
-    bool silent = rms < g_silenceThreshold;
-
-    std::cout << "[DEBUG][VoiceStream] RMS=" << rms
-              << " threshold=" << g_silenceThreshold
-              << " -> " << (silent ? "SILENCE" : "VOICE") << "\n";
-
-    return silent;
+// Audio kept from before the VAD opens so word onsets are not clipped
+constexpr size_t PRE_ROLL_SAMPLES = VoiceCapture::SAMPLE_RATE * 300 / 1000;
+
+// The room still echoes for a moment after playback stops
+constexpr auto ECHO_TAIL = std::chrono::milliseconds(400);
+
+// Speech audio waiting for the VAD to open
+static std::vector<float> preRoll;
+static bool inSegment = false;
+
+// Whisper usage counters (read by voice_stats)
+static std::mutex g_statsMutex;
+static VoiceStream::Stats g_stats;
+
+// Last block the VAD called speech; decodes starting well after it
+// count as Whisper work done while idle
+constexpr auto IDLE_AFTER = std::chrono::milliseconds(1000);
+static std::atomic<std::chrono::steady_clock::time_point> g_lastSpeechAt{};
+
+// Process-wide CPU time, not the calling thread's: whisper_full spreads
+// its work over ggml's compute threads, which a per-thread clock would
+// miss. The figure therefore also picks up whatever TTS/AI threads burn
+// during the decode window.
+static double processCpuMs() {
+#ifdef _WIN32
+    FILETIME create, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &create, &exit, &kernel, &user)) return 0.0;
+    auto toMs = [](const FILETIME& ft) {
+        ULARGE_INTEGER v;
+        v.LowPart  = ft.dwLowDateTime;
+        v.HighPart = ft.dwHighDateTime;
+        return static_cast<double>(v.QuadPart) / 10000.0;   // 100 ns ticks
+    };
+    return toMs(kernel) + toMs(user);
+#else
+    return 1000.0 * static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
 }
 
 // ---------------- Transcript Sanitizer ----------------
@@ -68,41 +91,405 @@ static std::string sanitizeTranscript(const std::string& input) {
     return out;
 }
 
-// ---------------- Whisper Incremental Processing ----------------
-static void processPCM(whisper_context* ctx, const std::vector<float>& buffer) {
-    if (buffer.size() <= VoiceStream::g_state.processedSamples) return;
+// ---------------- Speculative Dispatch ----------------
+// A committed partial that already parses to a complete command is
+// run after a short confirmation window of silence instead of the
+// full g_silenceTimeoutMs. Speech inside the window cancels it.
+struct SpeculationConfig {
+    bool   enabled       = true;
+    int    confirmMs     = 400;
+    double minConfidence = 0.5;
+};
+
+static SpeculationConfig loadSpeculationConfig() {
+    SpeculationConfig cfg;
+    if (aiConfig.is_object() && aiConfig.contains("whisper") &&
+        aiConfig["whisper"].contains("stream") &&
+        aiConfig["whisper"]["stream"].contains("speculative")) {
+        const auto& s = aiConfig["whisper"]["stream"]["speculative"];
+        cfg.enabled       = s.value("enabled", cfg.enabled);
+        cfg.confirmMs     = s.value("confirm_ms", cfg.confirmMs);
+        cfg.minConfidence = s.value("min_confidence", cfg.minConfidence);
+    }
+    cfg.confirmMs = std::max(0, cfg.confirmMs);
+    return cfg;
+}
 
-    // Add new samples
-    std::vector<float> newAudio(buffer.begin() + VoiceStream::g_state.processedSamples, buffer.end());
-    VoiceStream::g_state.processedSamples = buffer.size();
-    pcmAccumulator.insert(pcmAccumulator.end(), newAudio.begin(), newAudio.end());
+// Words a sentence does not end on; "open the" or "search for" is
+// still being spoken even if a rule happens to match it
+static bool endsDangling(const std::string& text) {
+    static const std::vector<std::string> kDangling = {
+        "the", "a", "an", "to", "for", "of", "in", "on", "and", "or",
+        "with", "my", "me", "about", "at", "from", "into", "please"
+    };
+    size_t pos = text.find_last_of(' ');
+    std::string last = (pos == std::string::npos) ? text : text.substr(pos + 1);
+    return std::find(kDangling.begin(), kDangling.end(), last) != kDangling.end();
+}
+
+static bool speculationReady(const Intent& intent, const std::string& clean,
+                             const SpeculationConfig& cfg) {
+    if (!intent.matched || intent.confidence < cfg.minConfidence) return false;
+    if (endsDangling(clean)) return false;
+    for (const auto& [name, value] : intent.slots) {
+        std::string v = sanitizeTranscript(value);
+        if (v.empty() || endsDangling(v)) return false;
+    }
+    return true;
+}
+
+// ---------------- Inference Worker ----------------
+// whisper_full runs here, never on the capture loop. The loop posts
+// jobs into a bounded queue; when the worker falls behind, new audio
+// is merged into the queued tail and audio older than one decode
+// window is dropped (the decoder would slide past it anyway).
+constexpr size_t MAX_QUEUED_JOBS = 8;
+
+struct InferenceJob {
+    enum class Kind { Audio, Flush, Reset };
+    Kind kind = Kind::Audio;
+    std::vector<float> pcm;
+    std::chrono::steady_clock::time_point queuedAt;
+};
+
+static std::mutex                 g_jobMutex;
+static std::condition_variable    g_jobCV;
+static std::deque<InferenceJob>   g_jobs;
+static std::thread                g_workerThread;
+static std::atomic<bool>          g_workerRunning{false};
+static std::atomic<bool>          g_workerBusy{false};
+static size_t                     g_maxJobSamples = 0;
+
+// Committed transcript, written by the worker and read by the loop
+static std::mutex g_partialMutex;
+
+static void recordQueueDepthLocked() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    g_stats.queueDepth = g_jobs.size();
+    g_stats.maxQueueDepth = std::max<uint64_t>(g_stats.maxQueueDepth, g_jobs.size());
+}
 
-    if (pcmAccumulator.size() < MIN_SAMPLES) {
-        std::cout << "[DEBUG][VoiceStream] Accumulating... ("
-                  << pcmAccumulator.size() << "/" << MIN_SAMPLES << " samples)\n";
+static void postJob(InferenceJob::Kind kind, const std::vector<float>* pcm = nullptr) {
+    {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        bool full = g_jobs.size() >= MAX_QUEUED_JOBS;
+
+        if (kind == InferenceJob::Kind::Audio && full &&
+            g_jobs.back().kind == InferenceJob::Kind::Audio) {
+            auto& tail = g_jobs.back().pcm;
+            tail.insert(tail.end(), pcm->begin(), pcm->end());
+
+            size_t dropped = 0;
+            if (tail.size() > g_maxJobSamples) {
+                dropped = tail.size() - g_maxJobSamples;
+                tail.erase(tail.begin(), tail.begin() + dropped);
+            }
+
+            std::lock_guard<std::mutex> statsLock(g_statsMutex);
+            g_stats.mergedJobs++;
+            g_stats.droppedSamples += dropped;
+        } else {
+            // Flush/Reset are never dropped; they are tiny and order matters
+            InferenceJob job;
+            job.kind = kind;
+            if (pcm) job.pcm = *pcm;
+            job.queuedAt = std::chrono::steady_clock::now();
+            g_jobs.push_back(std::move(job));
+        }
+        recordQueueDepthLocked();
+    }
+    g_jobCV.notify_one();
+}
+
+static bool workerIdle() {
+    std::lock_guard<std::mutex> lock(g_jobMutex);
+    return g_jobs.empty() && !g_workerBusy;
+}
+
+template <typename Fn>
+static void timedDecode(Fn&& fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    bool idle = t0 - g_lastSpeechAt.load() > IDLE_AFTER;
+    double cpu0 = processCpuMs();
+    StreamDecoder::Result r = fn();
+    double cpuMs = processCpuMs() - cpu0;
+    double wallMs = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - t0).count();
+
+    if (r.ran) {
+        std::lock_guard<std::mutex> lock(g_statsMutex);
+        g_stats.whisperCalls++;
+        g_stats.whisperWallMs += wallMs;
+        g_stats.whisperCpuMs  += cpuMs;
+        g_stats.maxWhisperWallMs = std::max(g_stats.maxWhisperWallMs, wallMs);
+        if (idle) {
+            g_stats.idleWhisperCalls++;
+            g_stats.idleWhisperCpuMs += cpuMs;
+        }
+    }
+
+    // partial only ever grows by confirmed words; the tentative tail is display-only
+    std::string shown;
+    {
+        std::lock_guard<std::mutex> lock(g_partialMutex);
+        if (!r.committed.empty()) {
+            VoiceStream::g_state.partial += r.committed + " ";
+            LOG_DEBUG("VoiceStream", "Committed: " + r.committed);
+        }
+        shown = VoiceStream::g_state.partial + r.tentative;
+    }
+    if (r.ran || !r.committed.empty()) {
+        ui_set_textbox(shown);
+    }
+}
+
+static void workerLoop(whisper_context* ctx, StreamDecoder::Config cfg) {
+    StreamDecoder decoder(cfg);
+
+    while (true) {
+        std::vector<InferenceJob> batch;
+        {
+            std::unique_lock<std::mutex> lock(g_jobMutex);
+            g_jobCV.wait(lock, [] { return !g_jobs.empty() || !g_workerRunning; });
+            if (g_jobs.empty() && !g_workerRunning) break;
+
+            // Take every audio job up to the next control job in one go:
+            // pushing is cheap, only the decode after it is expensive
+            do {
+                batch.push_back(std::move(g_jobs.front()));
+                g_jobs.pop_front();
+            } while (!g_jobs.empty() && batch.back().kind == InferenceJob::Kind::Audio);
+
+            g_workerBusy = true;
+            recordQueueDepthLocked();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(g_statsMutex);
+            for (const auto& job : batch) {
+                g_stats.queueWaitMs += std::chrono::duration<double, std::milli>(
+                                           now - job.queuedAt).count();
+                g_stats.jobsProcessed++;
+            }
+        }
+
+        for (auto& job : batch) {
+            switch (job.kind) {
+                case InferenceJob::Kind::Audio:
+                    decoder.push(job.pcm);
+                    break;
+                case InferenceJob::Kind::Flush:
+                    timedDecode([&] { return decoder.flush(ctx); });
+                    break;
+                case InferenceJob::Kind::Reset:
+                    decoder.reset();
+                    break;
+            }
+        }
+        if (decoder.ready()) {
+            timedDecode([&] { return decoder.decode(ctx); });
+        }
+
+        g_workerBusy = false;
+    }
+}
+
+static void startWorker(whisper_context* ctx) {
+    StreamDecoder::Config cfg = StreamDecoder::loadConfig();
+    {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        g_jobs.clear();
+        g_maxJobSamples = static_cast<size_t>(VoiceCapture::SAMPLE_RATE) *
+                          static_cast<size_t>(cfg.windowMs) / 1000;
+    }
+    g_workerRunning = true;
+    g_workerThread = std::thread(workerLoop, ctx, cfg);
+}
+
+static void stopWorker() {
+    {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        g_workerRunning = false;
+        g_jobs.clear();
+    }
+    g_jobCV.notify_all();
+    if (g_workerThread.joinable()) g_workerThread.join();
+}
+
+// ---------------- VAD-gated Processing ----------------
+// Only audio the VAD classifies as speech (plus pre-roll) is posted
+// to the inference worker; silent blocks just refresh the pre-roll.
+static void processPCM(const std::vector<float>& pcm, bool speech) {
+    double blockMs = 1000.0 * static_cast<double>(pcm.size()) / VoiceCapture::SAMPLE_RATE;
+
+    if (!speech) {
+        {
+            std::lock_guard<std::mutex> lock(g_statsMutex);
+            g_stats.idleMs += blockMs;
+            g_stats.skippedBlocks++;
+        }
+
+        // Speech just ended: commit whatever the window still holds
+        if (inSegment) {
+            postJob(InferenceJob::Kind::Flush);
+            inSegment = false;
+        }
+
+        preRoll.insert(preRoll.end(), pcm.begin(), pcm.end());
+        if (preRoll.size() > PRE_ROLL_SAMPLES) {
+            preRoll.erase(preRoll.begin(), preRoll.end() - PRE_ROLL_SAMPLES);
+        }
         return;
     }
 
-    whisper_full_params params = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
-    params.no_timestamps = true;
-    params.max_tokens = g_whisperMaxTokens;
-    params.language = g_whisperLanguage.c_str();
-
-    if (whisper_full(ctx, params, pcmAccumulator.data(), (int)pcmAccumulator.size()) == 0) {
-        int n = whisper_full_n_segments(ctx);
-        if (n > 0) {
-            std::string latest = whisper_full_get_segment_text(ctx, n - 1);
-            if (!latest.empty()) {
-                VoiceStream::g_state.partial += latest + " ";
-                ui_set_textbox(VoiceStream::g_state.partial);
-                std::cout << "[VoiceStream] Partial: " << latest << "\n";
+    {
+        std::lock_guard<std::mutex> lock(g_statsMutex);
+        g_stats.speechMs += blockMs;
+    }
+    g_lastSpeechAt = std::chrono::steady_clock::now();
+
+    if (!inSegment) {
+        if (!preRoll.empty()) postJob(InferenceJob::Kind::Audio, &preRoll);
+        preRoll.clear();
+        inSegment = true;
+    }
+    postJob(InferenceJob::Kind::Audio, &pcm);
+}
+
+// ---------------- AI Reply ----------------
+// The reply generates on the AI executor so the loop keeps listening;
+// speech while it runs can interrupt it (ai_bargein.hpp). Each
+// sentence is queued for TTS as soon as it is complete, so speaking
+// starts after the first sentence instead of the whole reply.
+struct SpokenReply {
+    Sentences::Options   options = Sentences::loadOptions();
+    Sentences::Segmenter segmenter{options};
+    std::string          text;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastChunk = start;
+    double               firstSentenceMs = -1.0;
+    uint64_t             sentences = 0;
+};
+
+static std::future<std::string>     g_pendingReply;
+static AIExecutor::CancelToken      g_replyToken;
+static std::shared_ptr<SpokenReply> g_spoken;
+static std::string                  g_replyInput;            // for the memory update
+static nlohmann::json*              g_replyMemory = nullptr;
+
+static void speakSentence(SpokenReply& spoken, const std::string& sentence,
+                          const AIExecutor::CancelToken& token) {
+    if (spoken.firstSentenceMs < 0.0) {
+        spoken.firstSentenceMs = std::chrono::duration<double, std::milli>(
+                                     std::chrono::steady_clock::now() - spoken.start).count();
+    }
+    spoken.sentences++;
+    Voice::speak(sentence, "routine", token);
+}
+
+// Push a finished reply to history; with wait, block until it finishes
+static void collectReply(ConsoleHistory* uiHistory, bool wait) {
+    if (!g_pendingReply.valid()) return;
+    if (!wait && g_pendingReply.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) return;
+
+    std::string reply;
+    try {
+        reply = g_pendingReply.get();
+    } catch (const std::exception& e) {
+        reply = std::string("[AI] Stream failed: ") + e.what();
+    }
+    BargeIn::endTurn(g_replyToken);
+    if (g_replyMemory) rememberStreamReply(*g_replyMemory, g_replyInput, reply);
+
+    if (reply == AIExecutor::REPLY_CANCELLED) {
+        std::cout << "\n";
+        uiHistory->push("[AI] (interrupted)", sf::Color(150, 150, 150));
+    } else {
+        uiHistory->push(reply.rfind("[AI] ", 0) == 0 ? reply : "[AI] " + reply, sf::Color::Green);
+
+        // The tail after the last boundary, or the whole reply when
+        // sentence streaming is off
+        auto spoken = std::move(g_spoken);
+        if (spoken && !g_replyToken.cancelled()) {
+            std::vector<std::string> rest;
+            if (spoken->options.enabled) {
+                std::string tail = spoken->segmenter.flush();
+                if (!tail.empty()) rest.push_back(std::move(tail));
+            } else {
+                rest = Sentences::split(spoken->text, spoken->options);
+            }
+            for (const auto& sentence : rest) speakSentence(*spoken, sentence, g_replyToken);
+
+            if (spoken->sentences > 0) {
+                std::lock_guard<std::mutex> lock(g_statsMutex);
+                g_stats.spokenReplies++;
+                g_stats.sentencesSpoken  += spoken->sentences;
+                g_stats.firstSentenceMs  += spoken->firstSentenceMs;
+                g_stats.replyGenerationMs += std::chrono::duration<double, std::milli>(
+                                                 spoken->lastChunk - spoken->start).count();
             }
         }
+    }
+    g_spoken.reset();
+    ui_set_textbox("");
+}
+
+// ---------------- Dispatch ----------------
+static void dispatchUtterance(const std::string& utterance,
+                              const Intent& intent,
+                              ConsoleHistory* uiHistory,
+                              nlohmann::json& uiLongTermMemory) {
+    std::string clean = sanitizeTranscript(utterance);
+
+    if (intent.matched) {
+        std::cout << "[VoiceStream] Dispatching command: " << intent.name << "\n";
+        handleCommand(clean);
     } else {
-        std::cerr << "[VoiceStream] ERROR: whisper_full() failed\n";
+        // A reply still generating is outdated now
+        if (g_pendingReply.valid()) {
+            g_replyToken.cancel();
+            collectReply(uiHistory, true);
+        }
+        g_replyToken  = BargeIn::beginTurn();
+        g_spoken      = std::make_shared<SpokenReply>();
+        g_replyInput  = utterance;
+        g_replyMemory = &uiLongTermMemory;
+
+        // Runs on the executor; collectReply reads spoken and updates
+        // memory only after the future is ready, on this thread
+        g_pendingReply = ai_process_stream_async(
+            utterance,
+            [spoken = g_spoken, token = g_replyToken](const std::string& chunk) {
+                spoken->text += chunk;
+                spoken->lastChunk = std::chrono::steady_clock::now();
+                ui_set_textbox(spoken->text);
+                std::cout << chunk << std::flush;
+
+                if (spoken->options.enabled && !token.cancelled()) {
+                    for (const auto& sentence : spoken->segmenter.push(chunk)) {
+                        speakSentence(*spoken, sentence, token);
+                    }
+                }
+            },
+            {AIExecutor::Priority::Interactive, g_replyToken});
+        return;   // textbox is cleared by collectReply
     }
 
-    pcmAccumulator.clear();
+    ui_set_textbox("");
+}
+
+static void recordDispatch(bool speculative, std::chrono::steady_clock::time_point speechEnd) {
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - speechEnd).count();
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    if (speculative) {
+        g_stats.speculativeDispatches++;
+        g_stats.speculativeLatencyMs += ms;
+    } else {
+        g_stats.timeoutDispatches++;
+        g_stats.timeoutLatencyMs += ms;
+    }
 }
 
 // ---------------- Core Loop ----------------
@@ -112,123 +499,146 @@ static void run(whisper_context* ctx,
                 nlohmann::json& uiLongTermMemory,
                 NLP& nlp) {
     VoiceStream::g_state.partial.clear();
-    VoiceStream::g_state.processedSamples = 0;
-    pcmAccumulator.clear();
-
-    if (Pa_Initialize() != paNoError) {
-        uiHistory->push("[VoiceStream] ERROR: Failed to initialize PortAudio", sf::Color::Red);
-        VoiceStream::g_state.running = false;
-        return;
-    }
-
-    int deviceIndex = (VoiceStream::g_state.inputDeviceIndex >= 0) ? VoiceStream::g_state.inputDeviceIndex
-                                                                   : Pa_GetDefaultInputDevice();
-    if (deviceIndex == paNoDevice || deviceIndex < 0 || deviceIndex >= Pa_GetDeviceCount()) {
-        uiHistory->push("[VoiceStream] ERROR: No valid input device found", sf::Color::Red);
-        Pa_Terminate();
-        VoiceStream::g_state.running = false;
-        return;
-    }
+    preRoll.clear();
+    inSegment = false;
 
-    const PaDeviceInfo* devInfo = Pa_GetDeviceInfo(deviceIndex);
-
-    PaStreamParameters inputParams;
-    inputParams.device = deviceIndex;
-    inputParams.channelCount = 1;
-    inputParams.sampleFormat = paFloat32;
-    inputParams.suggestedLatency = devInfo->defaultLowInputLatency;
-    inputParams.hostApiSpecificStreamInfo = nullptr;
-
-    PaStream* stream = nullptr;
-    if (Pa_OpenStream(&stream,
-                      &inputParams,
-                      nullptr,
-                      16000,
-                      512,
-                      paNoFlag,
-                      [](const void* input, void*, unsigned long frameCount,
-                         const PaStreamCallbackTimeInfo*, PaStreamCallbackFlags, void* userData) -> int {
-                          auto* audio = reinterpret_cast<VoiceStream::State::AudioData*>(userData);
-                          const float* in = static_cast<const float*>(input);
-                          if (in) {
-                              std::lock_guard<std::mutex> lock(audio->mtx);
-                              audio->buffer.insert(audio->buffer.end(), in, in + frameCount);
-                              audio->ready = true;
-                          }
-                          return paContinue;
-                      },
-                      &VoiceStream::g_state.audio) != paNoError || !stream) {
-        uiHistory->push("[VoiceStream] ERROR: Could not open mic stream", sf::Color::Red);
-        Pa_Terminate();
+    // 🔹 Shared capture engine (no per-mode PortAudio init)
+    if (!VoiceCapture::init(VoiceStream::g_state.inputDeviceIndex)) {
+        uiHistory->push("[VoiceStream] ERROR: Could not start microphone capture", sf::Color::Red);
         VoiceStream::g_state.running = false;
         return;
     }
 
-    if (Pa_StartStream(stream) != paNoError) {
-        uiHistory->push("[VoiceStream] ERROR: Could not start mic stream", sf::Color::Red);
-        Pa_CloseStream(stream);
-        Pa_Terminate();
+    VoiceCapture::Buffer capture("stream");
+    if (!capture.valid()) {
+        uiHistory->push("[VoiceStream] ERROR: Could not subscribe to microphone", sf::Color::Red);
         VoiceStream::g_state.running = false;
         return;
     }
 
     uiHistory->push("[VoiceStream] Listening...", sf::Color(0, 200, 255));
     auto lastSpeechTime = std::chrono::steady_clock::now();
+    VAD::Detector vad;
+    SpeculationConfig spec = loadSpeculationConfig();
+    BargeIn::Gate barge;
+    auto lastSpokenAt = std::chrono::steady_clock::time_point{};
+    bool talkingOver  = false;   // barged in, still speaking
+    startWorker(ctx);
+
+    // Partial last checked for early dispatch, and whether it qualified
+    std::string specChecked;
+    Intent      specIntent;
+    bool        specArmed = false;
 
     while (VoiceStream::g_state.running) {
         std::vector<float> pcm;
-        {
-            std::lock_guard<std::mutex> lock(VoiceStream::g_state.audio.mtx);
-            if (VoiceStream::g_state.audio.ready) {
-                pcm = VoiceStream::g_state.audio.buffer;
-                VoiceStream::g_state.audio.ready = false;
-                VoiceStream::g_state.audio.buffer.clear();
-            }
-        }
+        capture.wait(pcm, 50);
+
+        collectReply(uiHistory, false);
 
         if (!pcm.empty()) {
-            processPCM(ctx, pcm);
+            bool vadSpeech = vad.process(pcm);
+
+            // The user talks over the assistant: stop generating and
+            // speaking. The assistant's own voice in the mic does not count.
+            float rms = VAD::analyzeFrame(pcm.data(), pcm.size()).rms;
+            bool interrupted = barge.process(vadSpeech, rms, Voice::isPlaying(),
+                                             1000.0 * pcm.size() / VoiceCapture::SAMPLE_RATE);
+            if (interrupted) BargeIn::interrupt();
+
+            // While speech is queued or playing (and its echo fades) the
+            // mic only feeds the gate above: otherwise the assistant would
+            // transcribe itself and answer its own reply. A barge-in lifts
+            // this until the user pauses; the pre-roll keeps their first words.
+            if (interrupted) {
+                talkingOver = true;
+            } else if (!vadSpeech) {
+                talkingOver = false;
+            }
+            if (!talkingOver && Voice::isSpeaking()) {
+                lastSpokenAt = std::chrono::steady_clock::now();
+            }
+            bool muted = !talkingOver &&
+                         std::chrono::steady_clock::now() - lastSpokenAt < ECHO_TAIL;
+            bool speech = vadSpeech && !muted;
+            processPCM(pcm, speech);
 
-            if (!isSilence(pcm)) {
+            if (speech) {
                 lastSpeechTime = std::chrono::steady_clock::now();
+
+                // More speech inside the confirmation window: the user
+                // is not done, wait for the longer partial
+                if (specArmed) {
+                    specArmed = false;
+                    specChecked.clear();
+                    std::lock_guard<std::mutex> lock(g_statsMutex);
+                    g_stats.speculationsCancelled++;
+                }
             }
 
             auto now = std::chrono::steady_clock::now();
             auto silenceMs =
                 std::chrono::duration_cast<std::chrono::milliseconds>(now - lastSpeechTime).count();
 
-            if (!VoiceStream::g_state.partial.empty() && silenceMs > g_silenceTimeoutMs) {
-                std::string clean = sanitizeTranscript(VoiceStream::g_state.partial);
-                Intent intent = nlp.parse(clean);
-
-                if (intent.matched) {
-                    std::cout << "[VoiceStream] Dispatching command: " << intent.name << "\n";
-                    handleCommand(clean);
-                } else {
-                    std::string fullReply;
-                    ai_process_stream(
-                        VoiceStream::g_state.partial,
-                        uiLongTermMemory,
-                        [&](const std::string& chunk) {
-                            fullReply += chunk;
-                            ui_set_textbox(fullReply);
-                            std::cout << chunk << std::flush;
-                        });
-                    uiHistory->push("[AI] " + fullReply, sf::Color::Green);
+            // Re-parse the committed partial whenever it changes during a pause
+            if (spec.enabled && !speech && workerIdle()) {
+                std::string snapshot;
+                {
+                    std::lock_guard<std::mutex> lock(g_partialMutex);
+                    snapshot = VoiceStream::g_state.partial;
+                }
+                if (!snapshot.empty() && snapshot != specChecked) {
+                    specChecked = snapshot;
+                    std::string clean = sanitizeTranscript(snapshot);
+                    specIntent = nlp.parse(clean);
+                    specArmed = speculationReady(specIntent, clean, spec);
+                    if (specArmed) {
+                        std::lock_guard<std::mutex> lock(g_statsMutex);
+                        g_stats.speculationsArmed++;
+                    }
+                }
+
+                if (specArmed && silenceMs >= spec.confirmMs) {
+                    std::string utterance;
+                    {
+                        std::lock_guard<std::mutex> lock(g_partialMutex);
+                        utterance.swap(VoiceStream::g_state.partial);
+                    }
+                    postJob(InferenceJob::Kind::Reset);
+                    specArmed = false;
+                    specChecked.clear();
+
+                    recordDispatch(true, lastSpeechTime);
+                    dispatchUtterance(utterance, specIntent, uiHistory, uiLongTermMemory);
+                    continue;
                 }
+            }
 
-                VoiceStream::g_state.partial.clear();
-                ui_set_textbox("");
+            // Dispatch once the worker has committed the last segment;
+            // if it is still decoding, check again on the next block
+            if (silenceMs > g_silenceTimeoutMs && workerIdle()) {
+                std::string utterance;
+                {
+                    std::lock_guard<std::mutex> lock(g_partialMutex);
+                    utterance.swap(VoiceStream::g_state.partial);
+                }
+                if (utterance.empty()) continue;
+                postJob(InferenceJob::Kind::Reset);
+                specArmed = false;
+                specChecked.clear();
+
+                recordDispatch(false, lastSpeechTime);
+                dispatchUtterance(utterance, nlp.parse(sanitizeTranscript(utterance)),
+                                  uiHistory, uiLongTermMemory);
             }
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 
-    Pa_StopStream(stream);
-    Pa_CloseStream(stream);
-    Pa_Terminate();
-
+    stopWorker();
+    if (g_pendingReply.valid()) {
+        g_replyToken.cancel();
+        collectReply(uiHistory, true);
+    }
     uiHistory->push("[VoiceStream] Stopped.", sf::Color(0, 200, 255));
 }
 
@@ -237,6 +647,16 @@ bool VoiceStream::isRunning() {
     return g_state.running;
 }
 
+VoiceStream::Stats VoiceStream::getStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    return g_stats;
+}
+
+void VoiceStream::resetStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    g_stats = Stats{};
+}
+
 bool VoiceStream::start(whisper_context* ctx,
                         ConsoleHistory* history,
                         std::vector<Timer>& timers,
@@ -262,110 +682,75 @@ void VoiceStream::stop() {
     }
 }
 
-void VoiceStream::calibrateSilence() {
-    // TODO: implement real calibration
-    std::cout << "[VoiceStream] Calibrating silence threshold (stub)\n";
+float VoiceStream::calibrateSilence(int durationMs) {
+    // Measures the room and persists longTermMemory["voice_baseline"];
+    // every Detector created afterwards starts from that floor.
+    return VAD::calibrate(durationMs);
 }
 
 // ---------------- One-shot listenOnce ----------------
 std::string Voice::listenOnce() {
     LOG_DEBUG("Voice", "listenOnce() starting…");
 
-    if (Pa_Initialize() != paNoError) {
-        LOG_ERROR("Voice", "PortAudio init failed in listenOnce()");
+    // Awaits the bootstrap preload if it is still running
+    if (!WhisperPool::init(aiConfig)) {
+        LOG_ERROR("Voice", "Whisper model unavailable in listenOnce()");
         return "";
     }
 
-    int deviceIndex = Pa_GetDefaultInputDevice();
-    if (deviceIndex == paNoDevice) {
-        LOG_ERROR("Voice", "No valid input device for listenOnce()");
-        Pa_Terminate();
+    if (!VoiceCapture::init(VoiceStream::g_state.inputDeviceIndex)) {
+        LOG_ERROR("Voice", "Capture engine unavailable in listenOnce()");
         return "";
     }
 
-    const PaDeviceInfo* devInfo = Pa_GetDeviceInfo(deviceIndex);
-
-    PaStreamParameters inputParams;
-    inputParams.device = deviceIndex;
-    inputParams.channelCount = 1;
-    inputParams.sampleFormat = paFloat32;
-    inputParams.suggestedLatency = devInfo->defaultLowInputLatency;
-    inputParams.hostApiSpecificStreamInfo = nullptr;
-
-    struct TempAudio { std::vector<float> buffer; bool ready=false; std::mutex mtx; } audio;
-
-    auto cb = [](const void* input, void*, unsigned long frameCount,
-                 const PaStreamCallbackTimeInfo*, PaStreamCallbackFlags, void* userData) -> int {
-        auto* ad = reinterpret_cast<TempAudio*>(userData);
-        const float* in = static_cast<const float*>(input);
-        if (in) {
-            std::lock_guard<std::mutex> lock(ad->mtx);
-            ad->buffer.insert(ad->buffer.end(), in, in + frameCount);
-            ad->ready = true;
-        }
-        return paContinue;
-    };
-
-    PaStream* stream = nullptr;
-    if (Pa_OpenStream(&stream, &inputParams, nullptr,
-                      16000, 512, paNoFlag, cb, &audio) != paNoError || !stream) {
-        LOG_ERROR("Voice", "Could not open mic stream in listenOnce()");
-        Pa_Terminate();
+    VoiceCapture::Buffer capture("listen");
+    if (!capture.valid()) {
+        LOG_ERROR("Voice", "Could not subscribe to microphone in listenOnce()");
         return "";
     }
 
-    Pa_StartStream(stream);
-
     auto lastSpeechTime = std::chrono::steady_clock::now();
+    VAD::Detector vad;
     std::vector<float> pcmBuffer;
     std::string transcript;
 
+    // Only the speech span (plus pre-roll and a short tail) goes to
+    // Whisper: leading silence and the silence timeout would otherwise
+    // size audio_ctx for seconds of nothing
+    constexpr size_t TAIL_SAMPLES = VoiceCapture::SAMPLE_RATE * 200 / 1000;
+    bool   heardSpeech = false;
+    size_t speechEnd   = 0;   // end of the last speech block in pcmBuffer
+
     while (true) {
         std::vector<float> pcm;
-        {
-            std::lock_guard<std::mutex> lock(audio.mtx);
-            if (audio.ready) {
-                pcm = audio.buffer;
-                audio.buffer.clear();
-                audio.ready = false;
-            }
-        }
+        capture.wait(pcm, 50);
 
         if (!pcm.empty()) {
             pcmBuffer.insert(pcmBuffer.end(), pcm.begin(), pcm.end());
 
-            if (!isSilence(pcm)) {
+            if (vad.process(pcm)) {
                 lastSpeechTime = std::chrono::steady_clock::now();
+                heardSpeech = true;
+                speechEnd   = pcmBuffer.size();
+            } else if (!heardSpeech && pcmBuffer.size() > PRE_ROLL_SAMPLES) {
+                // Before speech only the pre-roll is worth keeping
+                pcmBuffer.erase(pcmBuffer.begin(), pcmBuffer.end() - PRE_ROLL_SAMPLES);
             }
 
             auto now = std::chrono::steady_clock::now();
             auto silenceMs =
                 std::chrono::duration_cast<std::chrono::milliseconds>(now - lastSpeechTime).count();
 
-            if (silenceMs > g_silenceTimeoutMs && !pcmBuffer.empty()) {
-                whisper_context* ctx = Voice::getWhisperContext();
-                whisper_full_params params = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
-                params.no_timestamps = true;
-                params.max_tokens = g_whisperMaxTokens;
-                params.language = g_whisperLanguage.c_str();
-
-                if (whisper_full(ctx, params, pcmBuffer.data(), (int)pcmBuffer.size()) == 0) {
-                    int n = whisper_full_n_segments(ctx);
-                    for (int i = 0; i < n; i++) {
-                        transcript += whisper_full_get_segment_text(ctx, i);
-                    }
+            if (silenceMs > g_silenceTimeoutMs) {
+                if (heardSpeech) {
+                    pcmBuffer.resize(std::min(pcmBuffer.size(), speechEnd + TAIL_SAMPLES));
+                    transcript = WhisperConstrained::transcribe(pcmBuffer);
                 }
                 break;
             }
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 
-    Pa_StopStream(stream);
-    Pa_CloseStream(stream);
-    Pa_Terminate();
-
     transcript = sanitizeTranscript(transcript);
     LOG_DEBUG("Voice", "listenOnce() finished: " + transcript);
     return transcript;
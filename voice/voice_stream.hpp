@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include "nlp/nlp.hpp"
@@ -12,29 +13,61 @@ struct whisper_context;
 
 namespace VoiceStream {
     struct State {
-        struct AudioData {
-            std::vector<float> buffer;
-            bool ready = false;
-            std::mutex mtx;
-        };
-
         bool running = false;
         int inputDeviceIndex = -1;
-        size_t processedSamples = 0;
         std::string partial;
-        AudioData audio;
+    };
+
+    // Whisper usage in streaming mode (speech vs. idle audio)
+    struct Stats {
+        uint64_t whisperCalls  = 0;
+        double   whisperWallMs = 0.0;
+        double   whisperCpuMs  = 0.0;  // process-wide CPU time across whisper_full calls
+        double   speechMs      = 0.0;  // audio the VAD classified as speech
+        double   idleMs        = 0.0;  // audio skipped as silence
+        uint64_t skippedBlocks = 0;
+        uint64_t idleWhisperCalls = 0;    // started over 1 s after the last speech
+        double   idleWhisperCpuMs = 0.0;
+
+        // Inference worker queue
+        uint64_t queueDepth       = 0;    // jobs waiting right now
+        uint64_t maxQueueDepth    = 0;
+        uint64_t jobsProcessed    = 0;
+        uint64_t mergedJobs       = 0;    // audio merged into a queued job (queue full)
+        uint64_t droppedSamples   = 0;    // audio older than one window discarded
+        double   queueWaitMs      = 0.0;  // summed enqueue → worker pickup
+        double   maxWhisperWallMs = 0.0;
+
+        // Speech end → command dispatch
+        uint64_t speculationsArmed     = 0;    // partial parsed to a complete command
+        uint64_t speculationsCancelled = 0;    // speech resumed inside the window
+        uint64_t speculativeDispatches = 0;
+        double   speculativeLatencyMs  = 0.0;  // summed speech end → dispatch
+        uint64_t timeoutDispatches     = 0;
+        double   timeoutLatencyMs      = 0.0;
+
+        // AI reply → speech (voice_sentences.hpp)
+        uint64_t spokenReplies     = 0;
+        uint64_t sentencesSpoken   = 0;
+        double   firstSentenceMs   = 0.0;  // summed dispatch → first sentence queued
+        double   replyGenerationMs = 0.0;  // summed dispatch → last token
     };
 
     extern State g_state;
 
     bool isRunning();
+    Stats getStats();
+    void resetStats();
     bool start(whisper_context* ctx,
                ConsoleHistory* history,
                std::vector<Timer>& timers,
                nlohmann::json& longTermMemory,
                NLP& nlp);
     void stop();
-    void calibrateSilence();
+
+    // Measure ambient noise and persist it as the VAD baseline.
+    // Returns the noise floor RMS, or a negative value on failure.
+    float calibrateSilence(int durationMs = 2000);
 }
 
 namespace Voice {
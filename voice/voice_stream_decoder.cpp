@@ -0,0 +1,223 @@
+#include "voice_stream_decoder.hpp"
+#include "voice_capture.hpp"
+#include "whisper_pool.hpp"
+#include "whisper_profiles.hpp"
+#include "ai/ai.hpp"
+#include "logger.hpp"
+
+#include <whisper.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+// Whisper drops anything shorter than ~100 ms
+constexpr size_t MIN_DECODE_SAMPLES = VoiceCapture::SAMPLE_RATE / 10;
+
+// Committed text tail re-tokenized for the prompt
+constexpr size_t PROMPT_TAIL_CHARS = 256;
+
+// ---------------- Word helpers ----------------
+static std::string normalizeWord(const std::string& w) {
+    std::string out;
+    out.reserve(w.size());
+    for (unsigned char c : w) {
+        if (std::isalnum(c) || c == '\'') out += static_cast<char>(std::tolower(c));
+    }
+    return out;
+}
+
+static bool sameWord(const std::string& a, const std::string& b) {
+    return normalizeWord(a) == normalizeWord(b);
+}
+
+static std::vector<std::string> splitWords(const std::string& text) {
+    std::vector<std::string> words;
+    std::istringstream iss(text);
+    std::string w;
+    while (iss >> w) {
+        if (!normalizeWord(w).empty()) words.push_back(w);
+    }
+    return words;
+}
+
+static std::string joinWords(const std::vector<std::string>& words) {
+    std::string out;
+    for (const auto& w : words) {
+        if (!out.empty()) out += ' ';
+        out += w;
+    }
+    return out;
+}
+
+// ============================================================
+// Config
+// ============================================================
+StreamDecoder::Config StreamDecoder::loadConfig() {
+    Config cfg;
+    if (aiConfig.is_object() && aiConfig.contains("whisper") &&
+        aiConfig["whisper"].contains("stream")) {
+        const auto& s = aiConfig["whisper"]["stream"];
+        cfg.windowMs        = s.value("window_ms", cfg.windowMs);
+        cfg.strideMs        = s.value("stride_ms", cfg.strideMs);
+        cfg.maxPromptTokens = s.value("prompt_tokens", cfg.maxPromptTokens);
+    }
+    cfg.windowMs        = std::clamp(cfg.windowMs, 1000, 30000);
+    cfg.strideMs        = std::clamp(cfg.strideMs, 200, cfg.windowMs);
+    cfg.maxPromptTokens = std::clamp(cfg.maxPromptTokens, 0, 224);
+    return cfg;
+}
+
+// ============================================================
+// StreamDecoder
+// ============================================================
+StreamDecoder::StreamDecoder(const Config& cfg) : cfg_(cfg) {}
+
+void StreamDecoder::push(const float* samples, size_t count) {
+    if (!samples || count == 0) return;
+
+    window_.insert(window_.end(), samples, samples + count);
+    newSamples_ += count;
+
+    const size_t maxSamples = static_cast<size_t>(VoiceCapture::SAMPLE_RATE) *
+                              static_cast<size_t>(cfg_.windowMs) / 1000;
+    if (window_.size() > maxSamples) {
+        window_.erase(window_.begin(), window_.end() - maxSamples);
+        trimmed_ = true;
+    }
+}
+
+bool StreamDecoder::ready() const {
+    const size_t stride = static_cast<size_t>(VoiceCapture::SAMPLE_RATE) *
+                          static_cast<size_t>(cfg_.strideMs) / 1000;
+    return newSamples_ >= stride && window_.size() >= MIN_DECODE_SAMPLES;
+}
+
+void StreamDecoder::reset() {
+    window_.clear();
+    newSamples_ = 0;
+    trimmed_ = false;
+    bufferWords_.clear();
+    pending_.clear();
+    committedText_.clear();
+    promptTokens_.clear();
+    promptDirty_ = false;
+}
+
+void StreamDecoder::refreshPrompt(whisper_context* ctx) {
+    if (!promptDirty_) return;
+    promptDirty_ = false;
+    promptTokens_.clear();
+    if (cfg_.maxPromptTokens <= 0 || committedText_.empty()) return;
+
+    std::string tail = committedText_.size() > PROMPT_TAIL_CHARS
+                           ? committedText_.substr(committedText_.size() - PROMPT_TAIL_CHARS)
+                           : committedText_;
+
+    std::vector<whisper_token> tokens(PROMPT_TAIL_CHARS);
+    int n = whisper_tokenize(ctx, tail.c_str(), tokens.data(), (int)tokens.size());
+    if (n < 0) {
+        tokens.resize(static_cast<size_t>(-n));
+        n = whisper_tokenize(ctx, tail.c_str(), tokens.data(), (int)tokens.size());
+    }
+    if (n <= 0) return;
+    tokens.resize(static_cast<size_t>(n));
+
+    // Most recent tokens carry the useful context
+    size_t keep = std::min(tokens.size(), static_cast<size_t>(cfg_.maxPromptTokens));
+    promptTokens_.assign(tokens.end() - keep, tokens.end());
+}
+
+std::vector<std::string> StreamDecoder::runWhisper(whisper_context* ctx) {
+    refreshPrompt(ctx);
+
+    WhisperProfiles::Profile profile = WhisperProfiles::get();
+    whisper_full_params params = WhisperProfiles::params(profile);
+    params.single_segment = true;
+    if (!promptTokens_.empty()) {
+        params.prompt_tokens   = promptTokens_.data();
+        params.prompt_n_tokens = (int)promptTokens_.size();
+    }
+
+    newSamples_ = 0;
+    WhisperPool::Lease lease;
+    if (lease.full(params, window_.data(), (int)window_.size()) != 0) {
+        LOG_ERROR("VoiceStream", "whisper_full() failed on stream window");
+        return {};
+    }
+    return splitWords(lease.text());
+}
+
+// The window still holds audio for words committed earlier; drop
+// those from the front of the new hypothesis before comparing.
+std::vector<std::string> StreamDecoder::stripOverlap(const std::vector<std::string>& hyp) const {
+    if (bufferWords_.empty() || hyp.empty()) return hyp;
+
+    size_t cut = 0;
+    // Allow a couple of leading words garbled by the window edge
+    for (size_t skip = 0; skip <= 2 && skip < hyp.size(); skip++) {
+        size_t maxK = std::min(bufferWords_.size(), hyp.size() - skip);
+        size_t minK = (skip == 0) ? 1 : 2;
+        for (size_t k = maxK; k >= minK; k--) {
+            if (std::equal(bufferWords_.end() - k, bufferWords_.end(),
+                           hyp.begin() + skip, sameWord)) {
+                cut = std::max(cut, skip + k);
+                break;
+            }
+        }
+    }
+
+    // Window never slid: the committed words are all still at its start
+    if (cut == 0 && !trimmed_) cut = std::min(bufferWords_.size(), hyp.size());
+
+    return {hyp.begin() + cut, hyp.end()};
+}
+
+std::string StreamDecoder::commitWords(const std::vector<std::string>& words) {
+    if (words.empty()) return "";
+    std::string text = joinWords(words);
+    bufferWords_.insert(bufferWords_.end(), words.begin(), words.end());
+    if (!committedText_.empty()) committedText_ += ' ';
+    committedText_ += text;
+    promptDirty_ = true;
+    return text;
+}
+
+StreamDecoder::Result StreamDecoder::decode(whisper_context* ctx) {
+    Result r;
+    if (!ctx || window_.size() < MIN_DECODE_SAMPLES) return r;
+
+    std::vector<std::string> fresh = stripOverlap(runWhisper(ctx));
+    r.ran = true;
+
+    // Local agreement: commit what this window and the last one share
+    size_t agree = 0;
+    while (agree < fresh.size() && agree < pending_.size() &&
+           sameWord(fresh[agree], pending_[agree])) {
+        agree++;
+    }
+
+    r.committed = commitWords({fresh.begin(), fresh.begin() + agree});
+    pending_.assign(fresh.begin() + agree, fresh.end());
+    r.tentative = joinWords(pending_);
+    return r;
+}
+
+StreamDecoder::Result StreamDecoder::flush(whisper_context* ctx) {
+    Result r;
+
+    // Audio arrived since the last decode: give it one final pass
+    std::vector<std::string> rest = pending_;
+    if (ctx && newSamples_ > 0 && window_.size() >= MIN_DECODE_SAMPLES) {
+        rest = stripOverlap(runWhisper(ctx));
+        r.ran = true;
+    }
+    r.committed = commitWords(rest);
+
+    window_.clear();
+    newSamples_ = 0;
+    trimmed_ = false;
+    bufferWords_.clear();
+    pending_.clear();
+    return r;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+struct whisper_context;
+
+// ============================================================
+// StreamDecoder — sliding-window streaming transcription
+// ============================================================
+// - Keeps the last windowMs of speech and re-decodes it every
+//   strideMs, so Whisper always sees seconds of context.
+// - Committed text is fed back as prompt tokens.
+// - Words are only committed once two consecutive windows agree
+//   on them (stable prefix); the rest stays tentative.
+// ============================================================
+class StreamDecoder {
+public:
+    struct Config {
+        int windowMs        = 4000;
+        int strideMs        = 1000;
+        int maxPromptTokens = 64;
+    };
+
+    struct Result {
+        bool        ran = false;    // whisper_full was invoked
+        std::string committed;      // newly confirmed text (append to partial)
+        std::string tentative;      // unconfirmed tail (display only)
+    };
+
+    static Config loadConfig();
+
+    explicit StreamDecoder(const Config& cfg = loadConfig());
+
+    // Append speech audio (16 kHz mono).
+    void push(const float* samples, size_t count);
+    void push(const std::vector<float>& pcm) { push(pcm.data(), pcm.size()); }
+
+    // True once a stride of new audio has arrived since the last decode.
+    bool ready() const;
+
+    // Decode the current window and commit the stable prefix.
+    Result decode(whisper_context* ctx);
+
+    // Speech segment ended: decode what is left and commit everything.
+    // Prompt context is kept for the next segment.
+    Result flush(whisper_context* ctx);
+
+    // Forget audio, hypotheses and prompt context.
+    void reset();
+
+private:
+    std::vector<std::string> runWhisper(whisper_context* ctx);
+    std::vector<std::string> stripOverlap(const std::vector<std::string>& hyp) const;
+    std::string commitWords(const std::vector<std::string>& words);
+    void refreshPrompt(whisper_context* ctx);
+
+    Config cfg_;
+    std::vector<float> window_;
+    size_t newSamples_ = 0;
+    bool trimmed_ = false;                   // window has slid past its first sample
+
+    std::vector<std::string> bufferWords_;   // words committed from the current window
+    std::vector<std::string> pending_;       // previous window's uncommitted words
+    std::string committedText_;              // everything committed (prompt source)
+    std::vector<int32_t> promptTokens_;
+    bool promptDirty_ = false;
+};
@@ -0,0 +1,340 @@
+#include "voice_tts_cache.hpp"
+#include "ai/ai.hpp"
+#include "resources.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace TtsCache {
+
+Options loadOptions() {
+    Options opt;
+    if (aiConfig.is_object() && aiConfig.contains("voice") &&
+        aiConfig["voice"].contains("cache")) {
+        const auto& c = aiConfig["voice"]["cache"];
+        opt.enabled  = c.value("enabled", opt.enabled);
+        opt.memoryMb = c.value("memory_mb", opt.memoryMb);
+        opt.diskMb   = c.value("disk_mb", opt.diskMb);
+        opt.maxChars = c.value("max_chars", opt.maxChars);
+        opt.dir      = c.value("dir", opt.dir);
+    }
+    fs::path dir = opt.dir.empty() ? fs::path("tts_cache") : fs::path(opt.dir);
+    if (dir.is_relative()) dir = fs::path(getResourcePath()) / dir;
+    opt.dir = dir.string();
+    return opt;
+}
+
+// ---------------- State ----------------
+// One LRU list per tier, most recently used at the front
+struct MemoryEntry {
+    std::shared_ptr<const Clip> clip;
+    std::list<std::string>::iterator pos;
+};
+struct DiskEntry {
+    size_t bytes = 0;
+    std::list<std::string>::iterator pos;
+};
+
+static std::mutex g_mutex;
+static bool       g_loaded = false;
+static Options    g_opt;
+static std::list<std::string> g_memoryOrder;
+static std::list<std::string> g_diskOrder;
+static std::unordered_map<std::string, MemoryEntry> g_memory;
+static std::unordered_map<std::string, DiskEntry>   g_disk;
+static Stats      g_stats;
+
+static constexpr char kMagic[8] = {'G', 'R', 'I', 'M', 'P', 'C', 'M', '1'};
+
+static size_t clipBytes(const Clip& clip) {
+    return clip.samples.size() * sizeof(std::int16_t);
+}
+
+static fs::path pathFor(const std::string& key) {
+    return fs::path(g_opt.dir) / (key + ".pcm");
+}
+
+// Caller holds g_mutex. Oldest file first, so the LRU order survives restarts.
+static void scanDisk() {
+    std::error_code ec;
+    fs::create_directories(g_opt.dir, ec);
+
+    std::vector<std::pair<fs::file_time_type, fs::directory_entry>> files;
+    for (const auto& entry : fs::directory_iterator(g_opt.dir, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".pcm") {
+            files.emplace_back(entry.last_write_time(ec), entry);
+        }
+    }
+    std::sort(files.begin(), files.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [time, entry] : files) {
+        std::string key = entry.path().stem().string();
+        g_diskOrder.push_front(key);
+        size_t bytes = static_cast<size_t>(entry.file_size(ec));
+        g_disk[key] = {bytes, g_diskOrder.begin()};
+        g_stats.diskBytes += bytes;
+    }
+    g_stats.diskEntries = g_disk.size();
+    LOG_DEBUG("Voice/Cache", "Indexed " + std::to_string(g_disk.size()) + " cached phrases in " + g_opt.dir);
+}
+
+// Caller holds g_mutex
+static void ensureLoaded() {
+    if (g_loaded) return;
+    g_loaded = true;
+    g_opt = loadOptions();
+    if (g_opt.enabled) scanDisk();
+}
+
+// Caller holds g_mutex
+static void evictMemory() {
+    size_t limit = g_opt.memoryMb * 1024 * 1024;
+    while (g_stats.memoryBytes > limit && !g_memoryOrder.empty()) {
+        auto it = g_memory.find(g_memoryOrder.back());
+        g_stats.memoryBytes -= clipBytes(*it->second.clip);
+        g_memory.erase(it);
+        g_memoryOrder.pop_back();
+        g_stats.evictions++;
+    }
+    g_stats.memoryEntries = g_memory.size();
+}
+
+// Caller holds g_mutex
+static void evictDisk() {
+    size_t limit = g_opt.diskMb * 1024 * 1024;
+    while (g_stats.diskBytes > limit && !g_diskOrder.empty()) {
+        const std::string& key = g_diskOrder.back();
+        std::error_code ec;
+        fs::remove(pathFor(key), ec);
+        g_stats.diskBytes -= g_disk[key].bytes;
+        g_disk.erase(key);
+        g_diskOrder.pop_back();
+        g_stats.evictions++;
+    }
+    g_stats.diskEntries = g_disk.size();
+}
+
+// Caller holds g_mutex
+static void insertMemory(const std::string& key, std::shared_ptr<const Clip> clip) {
+    auto it = g_memory.find(key);
+    if (it != g_memory.end()) {
+        g_stats.memoryBytes -= clipBytes(*it->second.clip);
+        g_memoryOrder.erase(it->second.pos);
+        g_memory.erase(it);
+    }
+    g_memoryOrder.push_front(key);
+    g_stats.memoryBytes += clipBytes(*clip);
+    g_memory[key] = {std::move(clip), g_memoryOrder.begin()};
+    evictMemory();
+}
+
+// Caller holds g_mutex
+static void touchDisk(const std::string& key) {
+    auto it = g_disk.find(key);
+    if (it == g_disk.end()) return;
+    g_diskOrder.splice(g_diskOrder.begin(), g_diskOrder, it->second.pos);
+    std::error_code ec;
+    fs::last_write_time(pathFor(key), fs::file_time_type::clock::now(), ec);
+}
+
+// ---------------- Files ----------------
+// magic, sample rate, channels, identity length, identity, s16le PCM.
+// The identity is the full (engine, speaker, speed, text) string, so
+// a hash collision reads as a miss instead of the wrong phrase.
+static bool writeClip(const fs::path& path, const std::string& identity, const Clip& clip) {
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        std::uint32_t header[3] = {clip.sampleRate, clip.channels,
+                                   static_cast<std::uint32_t>(identity.size())};
+        out.write(kMagic, sizeof(kMagic));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(identity.data(), static_cast<std::streamsize>(identity.size()));
+        out.write(reinterpret_cast<const char*>(clip.samples.data()),
+                  static_cast<std::streamsize>(clipBytes(clip)));
+        if (!out) return false;
+    }
+    // Readers never see a half-written file
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    return !ec;
+}
+
+static std::shared_ptr<Clip> readClip(const fs::path& path, const std::string& identity) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return nullptr;
+    auto size = static_cast<size_t>(in.tellg());
+    in.seekg(0);
+
+    char magic[sizeof(kMagic)];
+    std::uint32_t header[3] = {};
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || header[2] != identity.size()) {
+        return nullptr;
+    }
+    std::string stored(header[2], '\0');
+    in.read(stored.data(), static_cast<std::streamsize>(stored.size()));
+    if (!in || stored != identity) return nullptr;
+
+    size_t offset = sizeof(kMagic) + sizeof(header) + stored.size();
+    auto clip = std::make_shared<Clip>();
+    clip->sampleRate = header[0];
+    clip->channels   = header[1];
+    clip->samples.resize((size - offset) / sizeof(std::int16_t));
+    in.read(reinterpret_cast<char*>(clip->samples.data()),
+            static_cast<std::streamsize>(clipBytes(*clip)));
+    if (!in || clip->sampleRate == 0 || clip->samples.empty()) return nullptr;
+    return clip;
+}
+
+// ---------------- Keys ----------------
+static std::string identityOf(const std::string& text, const std::string& engine,
+                              const std::string& speaker, double speed) {
+    char speedText[16];
+    std::snprintf(speedText, sizeof(speedText), "%.3f", speed);
+    return engine + '\n' + speaker + '\n' + speedText + '\n' + text;
+}
+
+Key key(const std::string& text, const std::string& engine,
+        const std::string& speaker, double speed) {
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ensureLoaded();
+        if (!g_opt.enabled || text.empty() || text.size() > g_opt.maxChars) return {};
+    }
+
+    // FNV-1a, 64-bit
+    Key k;
+    k.identity = identityOf(text, engine, speaker, speed);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : k.identity) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    k.id = hex;
+    return k;
+}
+
+// ============================================================
+// Lookup / store
+// ============================================================
+std::shared_ptr<const Clip> find(const Key& key) {
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ensureLoaded();
+        if (!key || !g_opt.enabled) return nullptr;
+
+        auto it = g_memory.find(key.id);
+        if (it != g_memory.end()) {
+            g_memoryOrder.splice(g_memoryOrder.begin(), g_memoryOrder, it->second.pos);
+            g_stats.memoryHits++;
+            return it->second.clip;
+        }
+        if (!g_disk.count(key.id)) {
+            g_stats.misses++;
+            return nullptr;
+        }
+    }
+
+    // File read outside the lock
+    std::shared_ptr<const Clip> clip = readClip(pathFor(key.id), key.identity);
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (!clip) {
+        g_stats.misses++;
+        return nullptr;
+    }
+    g_stats.diskHits++;
+    touchDisk(key.id);
+    insertMemory(key.id, clip);
+    return clip;
+}
+
+bool contains(const Key& key) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    ensureLoaded();
+    return key && (g_memory.count(key.id) || g_disk.count(key.id));
+}
+
+void store(const Key& key, Clip clip) {
+    if (!key || clip.samples.empty() || clip.sampleRate == 0) return;
+
+    auto shared = std::make_shared<const Clip>(std::move(clip));
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ensureLoaded();
+        if (!g_opt.enabled) return;
+        insertMemory(key.id, shared);
+        g_stats.stores++;
+    }
+
+    fs::path path = pathFor(key.id);
+    if (!writeClip(path, key.identity, *shared)) {
+        LOG_ERROR("Voice/Cache", "Could not write " + path.string());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    size_t bytes = sizeof(kMagic) + 3 * sizeof(std::uint32_t) + key.identity.size() + clipBytes(*shared);
+    auto it = g_disk.find(key.id);
+    if (it != g_disk.end()) {
+        g_stats.diskBytes -= it->second.bytes;
+        g_diskOrder.erase(it->second.pos);
+    }
+    g_diskOrder.push_front(key.id);
+    g_disk[key.id] = {bytes, g_diskOrder.begin()};
+    g_stats.diskBytes += bytes;
+    evictDisk();
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    ensureLoaded();
+    for (const auto& key : g_diskOrder) {
+        std::error_code ec;
+        fs::remove(pathFor(key), ec);
+    }
+    g_memory.clear();
+    g_memoryOrder.clear();
+    g_disk.clear();
+    g_diskOrder.clear();
+    g_stats.memoryEntries = g_stats.memoryBytes = 0;
+    g_stats.diskEntries   = g_stats.diskBytes   = 0;
+}
+
+// ============================================================
+// Stats
+// ============================================================
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    ensureLoaded();
+    return g_stats;
+}
+
+void resetStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Stats sizes = g_stats;
+    g_stats = Stats{};
+    g_stats.memoryEntries = sizes.memoryEntries;
+    g_stats.memoryBytes   = sizes.memoryBytes;
+    g_stats.diskEntries   = sizes.diskEntries;
+    g_stats.diskBytes     = sizes.diskBytes;
+}
+
+} // namespace TtsCache
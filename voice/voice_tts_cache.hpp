@@ -0,0 +1,66 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// ============================================================
+// TtsCache — rendered speech for phrases that repeat
+// ============================================================
+// - Content-addressed: the key is the text plus everything that
+//   changes the audio (engine, speaker, speed), so a new voice
+//   never plays an old rendering.
+// - Two LRU tiers: decoded PCM in memory, raw PCM files on disk
+//   (survive restarts). A disk hit is promoted to memory.
+// - Only short phrases are kept (max_chars); long AI sentences
+//   rarely repeat and would push the canned replies out.
+// - Tuned by ai_config.json "voice" → "cache".
+// ============================================================
+namespace TtsCache {
+    struct Options {
+        bool        enabled  = true;
+        size_t      memoryMb = 32;
+        size_t      diskMb   = 256;
+        size_t      maxChars = 160;
+        std::string dir;     // empty: <resources>/tts_cache; relative: under resources
+    };
+    Options loadOptions();
+
+    struct Clip {
+        unsigned sampleRate = 0;
+        unsigned channels   = 1;
+        std::vector<std::int16_t> samples;
+    };
+
+    struct Key {
+        std::string id;         // hash, also the file name
+        std::string identity;   // engine, speaker, speed and text
+        explicit operator bool() const { return !id.empty(); }
+    };
+    // Empty if the text should not be cached (too long, disabled)
+    Key key(const std::string& text, const std::string& engine,
+            const std::string& speaker, double speed);
+
+    // Memory first, then disk; nullptr on a miss
+    std::shared_ptr<const Clip> find(const Key& key);
+    // Present in either tier (does not load it)
+    bool contains(const Key& key);
+    void store(const Key& key, Clip clip);
+
+    // Drop both tiers
+    void clear();
+
+    struct Stats {
+        uint64_t memoryHits    = 0;
+        uint64_t diskHits      = 0;
+        uint64_t misses        = 0;
+        uint64_t stores        = 0;
+        uint64_t evictions     = 0;
+        size_t   memoryEntries = 0;
+        size_t   memoryBytes   = 0;
+        size_t   diskEntries   = 0;
+        size_t   diskBytes     = 0;
+    };
+    Stats getStats();
+    void  resetStats();   // counters only
+}
@@ -0,0 +1,236 @@
+#include "voice_vad.hpp"
+#include "ai/ai.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GRIM_VAD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define GRIM_VAD_NEON 1
+#endif
+
+namespace VAD {
+
+// ============================================================
+// Frame kernel: sum of squares + zero crossings in one pass
+// ============================================================
+FrameStats analyzeFrame(const float* x, size_t n) {
+    FrameStats st;
+    if (!x || n == 0) return st;
+
+    double energy = 0.0;
+    size_t crossings = 0;
+    size_t i = 0;
+
+#if defined(GRIM_VAD_SSE2)
+    __m128 acc  = _mm_setzero_ps();
+    __m128 zero = _mm_setzero_ps();
+    // Needs x[i+4] for the crossing compare, so stop one vector early
+    for (; i + 4 < n; i += 4) {
+        __m128 a = _mm_loadu_ps(x + i);
+        __m128 b = _mm_loadu_ps(x + i + 1);
+        acc = _mm_add_ps(acc, _mm_mul_ps(a, a));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(_mm_mul_ps(a, b), zero));
+        crossings += static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    energy = static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+#elif defined(GRIM_VAD_NEON)
+    float32x4_t acc  = vdupq_n_f32(0.0f);
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t  zc   = vdupq_n_u32(0);
+    for (; i + 4 < n; i += 4) {
+        float32x4_t a = vld1q_f32(x + i);
+        float32x4_t b = vld1q_f32(x + i + 1);
+        acc = vmlaq_f32(acc, a, a);
+        zc  = vaddq_u32(zc, vshrq_n_u32(vcltq_f32(vmulq_f32(a, b), zero), 31));
+    }
+    energy = static_cast<double>(vgetq_lane_f32(acc, 0)) + vgetq_lane_f32(acc, 1) +
+             vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3);
+    crossings = vgetq_lane_u32(zc, 0) + vgetq_lane_u32(zc, 1) +
+                vgetq_lane_u32(zc, 2) + vgetq_lane_u32(zc, 3);
+#endif
+
+    // Scalar tail (and full fallback)
+    for (; i < n; i++) {
+        energy += static_cast<double>(x[i]) * x[i];
+        if (i + 1 < n && x[i] * x[i + 1] < 0.0f) crossings++;
+    }
+
+    st.rms = static_cast<float>(std::sqrt(energy / static_cast<double>(n)));
+    st.zcr = (n > 1) ? static_cast<float>(crossings) / static_cast<float>(n - 1) : 0.0f;
+    return st;
+}
+
+// ============================================================
+// Config
+// ============================================================
+Config loadConfig() {
+    Config cfg;
+    if (aiConfig.is_object() && aiConfig.contains("voice") && aiConfig["voice"].contains("vad")) {
+        const auto& v = aiConfig["voice"]["vad"];
+        cfg.minRms         = v.value("min_rms", cfg.minRms);
+        cfg.noiseRatio     = v.value("noise_ratio", cfg.noiseRatio);
+        cfg.maxNoiseZcr    = v.value("max_noise_zcr", cfg.maxNoiseZcr);
+        cfg.attackFrames   = v.value("attack_frames", cfg.attackFrames);
+        cfg.hangoverFrames = v.value("hangover_frames", cfg.hangoverFrames);
+        cfg.adaptRate      = v.value("adapt_rate", cfg.adaptRate);
+    }
+
+    // Seed from the calibrated baseline; otherwise derive it from the
+    // static silence threshold so uncalibrated behaviour is unchanged.
+    // Read from the config here: g_silenceThreshold is only loaded by
+    // the voice demo.
+    double baseline = 0.0;
+    if (longTermMemory.is_object() && longTermMemory.contains("voice_baseline") &&
+        longTermMemory["voice_baseline"].is_number()) {
+        baseline = longTermMemory["voice_baseline"].get<double>();
+    }
+    if (baseline > 0.0) {
+        cfg.initialFloor = static_cast<float>(baseline);
+    } else if (cfg.noiseRatio > 0.0f) {
+        // voice.silence_threshold, else the legacy top-level key
+        double threshold = aiConfig.is_object() ? aiConfig.value("silence_threshold", 0.02) : 0.02;
+        if (aiConfig.is_object() && aiConfig.contains("voice") && aiConfig["voice"].is_object()) {
+            threshold = aiConfig["voice"].value("silence_threshold", threshold);
+        }
+        cfg.initialFloor = static_cast<float>(threshold) / cfg.noiseRatio;
+    }
+    return cfg;
+}
+
+// ============================================================
+// Detector
+// ============================================================
+Detector::Detector(const Config& cfg) : cfg_(cfg) {
+    reset();
+}
+
+void Detector::reset() {
+    noiseFloor_ = cfg_.initialFloor;
+    inSpeech_   = false;
+    speechRun_  = 0;
+    hangover_   = 0;
+    carry_.clear();
+}
+
+float Detector::threshold() const {
+    return std::max(cfg_.minRms, noiseFloor_ * cfg_.noiseRatio);
+}
+
+bool Detector::classify(const FrameStats& st) const {
+    float thr = threshold();
+    if (st.rms < thr) return false;
+    // Broadband hiss crosses zero constantly; require clear energy margin
+    if (st.zcr > cfg_.maxNoiseZcr && st.rms < thr * 2.0f) return false;
+    return true;
+}
+
+void Detector::step(const FrameStats& st) {
+    bool speech = classify(st);
+
+    if (speech) {
+        speechRun_++;
+        if (speechRun_ >= cfg_.attackFrames) {
+            inSpeech_ = true;
+            hangover_ = cfg_.hangoverFrames;
+        }
+    } else {
+        speechRun_ = 0;
+        if (hangover_ > 0) {
+            hangover_--;
+        } else {
+            inSpeech_ = false;
+        }
+
+        // Track the floor only while nobody is talking: fall fast, rise slowly
+        if (!inSpeech_) {
+            float rate = (st.rms < noiseFloor_) ? cfg_.adaptRate * 4.0f : cfg_.adaptRate;
+            rate = std::min(rate, 1.0f);
+            noiseFloor_ += (st.rms - noiseFloor_) * rate;
+        }
+    }
+
+    if (inSpeech_) blockSpeech_ = true;
+}
+
+bool Detector::process(const float* samples, size_t count) {
+    blockSpeech_ = inSpeech_;
+    if (!samples || count == 0) return blockSpeech_;
+
+    size_t i = 0;
+
+    // Complete a frame left over from the previous call
+    if (!carry_.empty()) {
+        size_t need = FRAME_SAMPLES - carry_.size();
+        size_t take = std::min(need, count);
+        carry_.insert(carry_.end(), samples, samples + take);
+        i = take;
+        if (carry_.size() < FRAME_SAMPLES) return blockSpeech_;
+        step(analyzeFrame(carry_.data(), carry_.size()));
+        carry_.clear();
+    }
+
+    for (; i + FRAME_SAMPLES <= count; i += FRAME_SAMPLES) {
+        step(analyzeFrame(samples + i, FRAME_SAMPLES));
+    }
+
+    if (i < count) carry_.assign(samples + i, samples + count);
+    return blockSpeech_;
+}
+
+// ============================================================
+// Calibration
+// ============================================================
+float calibrate(int durationMs) {
+    LOG_DEBUG("VAD", "Calibrating noise floor for " + std::to_string(durationMs) + " ms");
+
+    if (!VoiceCapture::init()) return -1.0f;
+    VoiceCapture::Buffer capture("calibrate");
+    if (!capture.valid()) return -1.0f;
+
+    const size_t wanted = static_cast<size_t>(VoiceCapture::SAMPLE_RATE) *
+                          static_cast<size_t>(durationMs) / 1000;
+    std::vector<float> pcm;
+    pcm.reserve(wanted);
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(durationMs + 1000);
+    while (pcm.size() < wanted && std::chrono::steady_clock::now() < deadline) {
+        capture.wait(pcm, 100);
+    }
+
+    if (pcm.size() < FRAME_SAMPLES) {
+        LOG_ERROR("VAD", "Calibration captured no audio");
+        return -1.0f;
+    }
+
+    // Median frame energy is robust to a cough or door slam during calibration
+    std::vector<float> levels;
+    levels.reserve(pcm.size() / FRAME_SAMPLES);
+    for (size_t i = 0; i + FRAME_SAMPLES <= pcm.size(); i += FRAME_SAMPLES) {
+        levels.push_back(analyzeFrame(pcm.data() + i, FRAME_SAMPLES).rms);
+    }
+    std::nth_element(levels.begin(), levels.begin() + levels.size() / 2, levels.end());
+    float floor = levels[levels.size() / 2];
+
+    longTermMemory["voice_baseline"] = floor;
+    saveMemory();
+
+    Config cfg = loadConfig();
+    LOG_DEBUG("VAD", "Noise floor=" + std::to_string(floor) +
+                     " → speech threshold=" +
+                     std::to_string(std::max(cfg.minRms, floor * cfg.noiseRatio)));
+    LOG_PHASE("Voice calibration", true);
+    return floor;
+}
+
+} // namespace VAD
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "voice_capture.hpp"
+
+// ============================================================
+// VAD — shared voice-activity detector
+// ============================================================
+// - Per-frame (20 ms) energy + zero-crossing analysis.
+// - Attack/hangover smoothing so short dips don't end speech.
+// - Noise floor adapts during silence; calibrate() measures the
+//   room and persists it to longTermMemory["voice_baseline"].
+// ============================================================
+namespace VAD {
+    constexpr int    FRAME_MS      = 20;
+    constexpr size_t FRAME_SAMPLES = VoiceCapture::SAMPLE_RATE * FRAME_MS / 1000;
+
+    struct FrameStats {
+        float rms = 0.0f;   // root-mean-square energy
+        float zcr = 0.0f;   // zero crossings per sample (0..1)
+    };
+
+    // Vectorized kernel (SSE2 / NEON, scalar fallback).
+    FrameStats analyzeFrame(const float* samples, size_t count);
+
+    struct Config {
+        float minRms         = 0.005f; // absolute floor for the speech threshold
+        float noiseRatio     = 3.0f;   // speech if rms > noiseFloor * noiseRatio
+        float maxNoiseZcr    = 0.35f;  // hiss: high ZCR with only marginal energy
+        int   attackFrames   = 2;      // consecutive speech frames to open
+        int   hangoverFrames = 15;     // frames kept open after energy drops
+        float adaptRate      = 0.05f;  // noise floor EMA rate during silence
+        float initialFloor   = 0.0f;   // seed (baseline or silence_threshold)
+    };
+
+    // Build config from aiConfig["voice"]["vad"] + persisted baseline.
+    Config loadConfig();
+
+    class Detector {
+    public:
+        explicit Detector(const Config& cfg = loadConfig());
+
+        // Feed any amount of audio; returns true if any frame in this
+        // block was (smoothed) speech.
+        bool process(const float* samples, size_t count);
+        bool process(const std::vector<float>& pcm) { return process(pcm.data(), pcm.size()); }
+
+        bool  inSpeech() const   { return inSpeech_; }
+        float noiseFloor() const { return noiseFloor_; }
+        float threshold() const;
+        void  reset();
+
+    private:
+        bool classify(const FrameStats& st) const;
+        void step(const FrameStats& st);
+
+        Config cfg_;
+        float noiseFloor_ = 0.0f;
+        bool  inSpeech_   = false;
+        bool  blockSpeech_ = false;
+        int   speechRun_  = 0;
+        int   hangover_   = 0;
+        std::vector<float> carry_;  // partial frame between calls
+    };
+
+    // Capture ambient audio for durationMs, derive the noise floor,
+    // persist it to longTermMemory["voice_baseline"] and return it.
+    // Returns a negative value if capture failed.
+    float calibrate(int durationMs = 2000);
+}
@@ -0,0 +1,309 @@
+#include "whisper_bench.hpp"
+#include "whisper_pool.hpp"
+#include "whisper_profiles.hpp"
+#include "voice_capture.hpp"
+#include "logger.hpp"
+
+#include <SFML/Audio.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+
+namespace fs = std::filesystem;
+
+namespace WhisperBench {
+
+// ============================================================
+// WAV loading (16 kHz mono float for Whisper)
+// ============================================================
+bool loadPcm16k(const std::string& path, std::vector<float>& out) {
+    sf::SoundBuffer buffer;
+    if (!buffer.loadFromFile(path)) {
+        LOG_ERROR("WhisperBench", "Failed to load audio: " + path);
+        return false;
+    }
+
+    const std::int16_t* samples = buffer.getSamples();
+    size_t channels = std::max(1u, buffer.getChannelCount());
+    size_t frames   = static_cast<size_t>(buffer.getSampleCount()) / channels;
+    double rate     = static_cast<double>(buffer.getSampleRate());
+    if (!samples || frames == 0 || rate <= 0.0) return false;
+
+    // Downmix
+    std::vector<float> mono(frames);
+    for (size_t f = 0; f < frames; f++) {
+        float sum = 0.0f;
+        for (size_t c = 0; c < channels; c++) sum += samples[f * channels + c];
+        mono[f] = sum / (32768.0f * static_cast<float>(channels));
+    }
+
+    if (static_cast<int>(rate) == VoiceCapture::SAMPLE_RATE) {
+        out.swap(mono);
+        return true;
+    }
+
+    // Linear resample is plenty for speech recognition input
+    double step = rate / VoiceCapture::SAMPLE_RATE;
+    size_t outFrames = static_cast<size_t>(static_cast<double>(frames) / step);
+    out.resize(outFrames);
+    for (size_t i = 0; i < outFrames; i++) {
+        double pos = static_cast<double>(i) * step;
+        size_t i0 = static_cast<size_t>(pos);
+        size_t i1 = std::min(i0 + 1, frames - 1);
+        float  t  = static_cast<float>(pos - static_cast<double>(i0));
+        out[i] = mono[i0] + (mono[i1] - mono[i0]) * t;
+    }
+    return true;
+}
+
+// ============================================================
+// Word error rate
+// ============================================================
+static std::vector<std::string> normalizedWords(const std::string& text) {
+    std::vector<std::string> words;
+    std::string cur;
+    for (unsigned char c : text) {
+        if (std::isalnum(c) || c == '\'') {
+            cur += static_cast<char>(std::tolower(c));
+        } else if (!cur.empty()) {
+            words.push_back(cur);
+            cur.clear();
+        }
+    }
+    if (!cur.empty()) words.push_back(cur);
+    return words;
+}
+
+size_t wordErrors(const std::string& reference, const std::string& hypothesis,
+                  size_t& refWords) {
+    std::vector<std::string> ref = normalizedWords(reference);
+    std::vector<std::string> hyp = normalizedWords(hypothesis);
+    refWords = ref.size();
+
+    // Levenshtein over words, two rolling rows
+    std::vector<size_t> prev(hyp.size() + 1), cur(hyp.size() + 1);
+    for (size_t j = 0; j <= hyp.size(); j++) prev[j] = j;
+    for (size_t i = 1; i <= ref.size(); i++) {
+        cur[0] = i;
+        for (size_t j = 1; j <= hyp.size(); j++) {
+            size_t sub = prev[j - 1] + (ref[i - 1] == hyp[j - 1] ? 0 : 1);
+            cur[j] = std::min({ sub, prev[j] + 1, cur[j - 1] + 1 });
+        }
+        prev.swap(cur);
+    }
+    return prev[hyp.size()];
+}
+
+// ============================================================
+// Pool concurrency
+// ============================================================
+std::vector<ConcurrencyResult> concurrency(const std::vector<float>& pcm,
+                                           int maxConcurrency, int jobsPerLevel) {
+    std::vector<ConcurrencyResult> results;
+    if (!WhisperPool::isLoaded() || pcm.empty() || jobsPerLevel <= 0) return results;
+
+    int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    maxConcurrency = std::clamp(maxConcurrency, 1, static_cast<int>(WhisperPool::capacity()));
+    double audioSec = static_cast<double>(pcm.size()) / VoiceCapture::SAMPLE_RATE;
+
+    for (int level = 1; level <= maxConcurrency; level *= 2) {
+        ConcurrencyResult r;
+        r.concurrency   = level;
+        r.threadsPerJob = std::max(1, hw / level);
+        r.jobs          = jobsPerLevel;
+
+        std::atomic<int>     next{0};
+        std::atomic<int64_t> jobMicros{0};
+        auto worker = [&] {
+            WhisperPool::Lease lease;
+            if (!lease.valid()) return;
+
+            WhisperProfiles::Profile profile = WhisperProfiles::get();
+            whisper_full_params params = WhisperProfiles::params(profile);
+            params.n_threads = r.threadsPerJob;
+
+            while (next.fetch_add(1) < jobsPerLevel) {
+                auto t0 = std::chrono::steady_clock::now();
+                lease.full(params, pcm.data(), (int)pcm.size());
+                jobMicros += std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - t0).count();
+            }
+        };
+
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < level; i++) threads.emplace_back(worker);
+        for (auto& t : threads) t.join();
+        r.wallMs = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - t0).count();
+
+        r.avgJobMs  = static_cast<double>(jobMicros.load()) / 1000.0 / jobsPerLevel;
+        r.realtimeX = r.wallMs > 0.0 ? audioSec * jobsPerLevel / (r.wallMs / 1000.0) : 0.0;
+        results.push_back(r);
+
+        LOG_DEBUG("WhisperBench", "Concurrency x" + std::to_string(level) + ": " +
+                                  std::to_string(r.wallMs) + " ms wall, " +
+                                  std::to_string(r.realtimeX) + "x realtime");
+    }
+    return results;
+}
+
+// ============================================================
+// Corpus: a single .wav or every .wav in a directory; a clip.txt
+// next to clip.wav is its reference transcript
+// ============================================================
+struct Clip {
+    std::string        name;
+    std::vector<float> pcm;
+    std::string        reference;
+    bool               hasRef = false;
+};
+
+static std::vector<Clip> loadCorpus(const std::string& path) {
+    std::vector<fs::path> files;
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.path().extension() == ".wav") files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+    } else if (fs::exists(path)) {
+        files.push_back(path);
+    }
+
+    std::vector<Clip> clips;
+    for (const auto& file : files) {
+        Clip clip;
+        clip.name = file.filename().string();
+        if (!loadPcm16k(file.string(), clip.pcm)) continue;
+
+        fs::path refPath = file;
+        refPath.replace_extension(".txt");
+        if (std::ifstream in{refPath}) {
+            std::stringstream ss;
+            ss << in.rdbuf();
+            clip.reference = ss.str();
+            clip.hasRef = true;
+        }
+        clips.push_back(std::move(clip));
+    }
+    return clips;
+}
+
+// ============================================================
+// Profile sweep (latency + WER)
+// ============================================================
+std::vector<ProfileResult> profiles(const std::string& corpusDir,
+                                    const std::vector<std::string>& profileNames) {
+    std::vector<ProfileResult> results;
+    if (!WhisperPool::isLoaded()) return results;
+
+    std::vector<Clip> clips = loadCorpus(corpusDir);
+    if (clips.empty()) return results;
+
+    WhisperPool::Lease lease;
+    if (!lease.valid()) return results;
+
+    for (const auto& name : profileNames) {
+        WhisperProfiles::Profile profile = WhisperProfiles::get(name);
+        whisper_full_params params = WhisperProfiles::params(profile);
+
+        ProfileResult r;
+        r.profile = profile.name;
+        size_t errors = 0, refWords = 0;
+
+        for (const auto& clip : clips) {
+            auto t0 = std::chrono::steady_clock::now();
+            int rc = lease.full(params, clip.pcm.data(), (int)clip.pcm.size());
+            double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+
+            r.files++;
+            r.audioSec += static_cast<double>(clip.pcm.size()) / VoiceCapture::SAMPLE_RATE;
+            r.totalMs  += ms;
+            r.maxMs     = std::max(r.maxMs, ms);
+
+            if (clip.hasRef) {
+                size_t words = 0;
+                errors   += wordErrors(clip.reference, rc == 0 ? lease.text(" ") : "", words);
+                refWords += words;
+            }
+        }
+
+        r.wer = refWords ? static_cast<double>(errors) / static_cast<double>(refWords) : -1.0;
+        results.push_back(r);
+
+        LOG_DEBUG("WhisperBench", "Profile " + r.profile + ": " +
+                                  std::to_string(r.totalMs / r.files) + " ms/clip, WER " +
+                                  std::to_string(r.wer));
+    }
+    return results;
+}
+
+// ============================================================
+// Short-command audio_ctx vs full encoder context
+// ============================================================
+std::vector<AudioCtxResult> audioCtx(const std::string& path, int repeats) {
+    std::vector<AudioCtxResult> results;
+    if (!WhisperPool::isLoaded()) return results;
+
+    std::vector<Clip> clips = loadCorpus(path);
+    WhisperPool::Lease lease;
+    if (clips.empty() || !lease.valid()) return results;
+    repeats = std::max(1, repeats);
+
+    WhisperProfiles::Profile profile = WhisperProfiles::get();
+
+    auto timeDecode = [&](const Clip& clip, whisper_full_params params, std::string& text) {
+        // One untimed pass so both modes are measured with warm buffers
+        lease.full(params, clip.pcm.data(), (int)clip.pcm.size());
+        double best = 0.0;
+        for (int i = 0; i < repeats; i++) {
+            auto t0 = std::chrono::steady_clock::now();
+            int rc = lease.full(params, clip.pcm.data(), (int)clip.pcm.size());
+            double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+            best = (i == 0) ? ms : std::min(best, ms);
+            text = (rc == 0) ? lease.text(" ") : "";
+        }
+        return best;
+    };
+
+    for (const auto& clip : clips) {
+        AudioCtxResult r;
+        r.clip     = clip.name;
+        r.audioSec = static_cast<double>(clip.pcm.size()) / VoiceCapture::SAMPLE_RATE;
+        r.audioCtx = WhisperProfiles::shortAudioCtx(clip.pcm.size());
+
+        whisper_full_params full = WhisperProfiles::params(profile);
+        full.audio_ctx = 0;
+        whisper_full_params shortCtx = full;
+        shortCtx.audio_ctx = r.audioCtx;
+
+        std::string fullText, shortText;
+        r.fullMs  = timeDecode(clip, full, fullText);
+        r.shortMs = r.audioCtx > 0 ? timeDecode(clip, shortCtx, shortText) : r.fullMs;
+        if (r.audioCtx == 0) shortText = fullText;
+
+        // Score against the reference when present, else against full context
+        const std::string& ref = clip.hasRef ? clip.reference : fullText;
+        size_t words = 0;
+        size_t errFull  = wordErrors(ref, fullText, words);
+        r.fullWer  = words ? static_cast<double>(errFull) / words : 0.0;
+        size_t errShort = wordErrors(ref, shortText, words);
+        r.shortWer = words ? static_cast<double>(errShort) / words : 0.0;
+        r.referenced = clip.hasRef;
+
+        results.push_back(r);
+        LOG_DEBUG("WhisperBench", "audio_ctx " + clip.name + ": " + std::to_string(r.fullMs) +
+                                  " ms → " + std::to_string(r.shortMs) + " ms (ctx=" +
+                                  std::to_string(r.audioCtx) + ")");
+    }
+    return results;
+}
+
+} // namespace WhisperBench
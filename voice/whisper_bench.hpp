@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// ============================================================
+// WhisperBench — offline measurements for the voice pipeline
+// ============================================================
+// - concurrency(): pool throughput at 1, 2, 4, ... parallel jobs.
+// - profiles():    latency + word error rate per decoding profile
+//                  over a WAV corpus (clip.wav + clip.txt pairs).
+// - audioCtx():    short-command encoder context vs full 30 s.
+// ============================================================
+namespace WhisperBench {
+    // Read a WAV file and convert to 16 kHz mono float.
+    bool loadPcm16k(const std::string& path, std::vector<float>& out);
+
+    // Word-level edit distance / reference length (case and
+    // punctuation insensitive). Returns edits; refWords is set.
+    size_t wordErrors(const std::string& reference, const std::string& hypothesis,
+                      size_t& refWords);
+
+    struct ConcurrencyResult {
+        int    concurrency   = 0;
+        int    threadsPerJob = 0;
+        int    jobs          = 0;
+        double wallMs        = 0.0;
+        double avgJobMs      = 0.0;
+        double realtimeX     = 0.0;   // audio seconds decoded per wall second
+    };
+
+    // For each level 1..maxConcurrency (doubling), run jobsPerLevel
+    // decodes of pcm across that many leases, splitting hardware
+    // threads evenly between them.
+    std::vector<ConcurrencyResult> concurrency(const std::vector<float>& pcm,
+                                               int maxConcurrency, int jobsPerLevel);
+
+    struct ProfileResult {
+        std::string profile;
+        int    files     = 0;
+        double audioSec  = 0.0;
+        double totalMs   = 0.0;
+        double maxMs     = 0.0;
+        double wer       = 0.0;      // 0..1, -1 if no references found
+    };
+
+    // Sweep profile names over every *.wav in corpusDir.
+    std::vector<ProfileResult> profiles(const std::string& corpusDir,
+                                        const std::vector<std::string>& profileNames);
+
+    struct AudioCtxResult {
+        std::string clip;
+        double audioSec   = 0.0;
+        int    audioCtx   = 0;       // 0 = clip too long, full context used
+        double fullMs     = 0.0;     // best of N, full encoder context
+        double shortMs    = 0.0;     // best of N, sized context
+        double fullWer    = 0.0;
+        double shortWer   = 0.0;
+        bool   referenced = false;   // WER vs .txt (else short vs full)
+    };
+
+    // Decode each clip (a .wav or a directory of them) with full and
+    // short-command audio_ctx using the active profile.
+    std::vector<AudioCtxResult> audioCtx(const std::string& path, int repeats = 3);
+}
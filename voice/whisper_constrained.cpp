@@ -0,0 +1,266 @@
+#include "whisper_constrained.hpp"
+#include "whisper_pool.hpp"
+#include "whisper_profiles.hpp"
+#include "ai/ai.hpp"
+#include "nlp/nlp.hpp"
+#include "aliases.hpp"
+#include "commands/commands_core.hpp"
+#include "logger.hpp"
+
+#include <whisper.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+namespace WhisperConstrained {
+
+// Alias tables can hold thousands of discovered apps; past a few
+// hundred words the bias stops meaning anything
+constexpr size_t MAX_ALIAS_WORDS = 256;
+
+// ---------------- Vocabulary ----------------
+struct Vocab {
+    std::vector<whisper_token> tokens;
+    std::string prompt;
+    size_t words = 0;
+    float  bias  = 0.0f;
+    std::tuple<uint64_t, size_t, uint64_t> signature;   // rules, commands, aliases
+};
+
+static std::mutex             g_vocabMutex;
+static std::shared_ptr<Vocab> g_vocab;
+
+static std::mutex g_statsMutex;
+static Stats      g_stats;
+
+// ============================================================
+// Config
+// ============================================================
+Config loadConfig() {
+    Config cfg;
+    if (aiConfig.is_object() && aiConfig.contains("whisper") &&
+        aiConfig["whisper"].contains("constrained")) {
+        const auto& c = aiConfig["whisper"]["constrained"];
+        cfg.enabled     = c.value("enabled", cfg.enabled);
+        cfg.bias        = c.value("bias", cfg.bias);
+        cfg.maxTokens   = c.value("max_tokens", cfg.maxTokens);
+        cfg.minProb     = c.value("min_prob", cfg.minProb);
+        cfg.promptWords = c.value("prompt_words", cfg.promptWords);
+    }
+    return cfg;
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_statsMutex);
+    return g_stats;
+}
+
+// ============================================================
+// Vocabulary building
+// ============================================================
+// Literal words inside a rule regex: drop escapes (\s, \d, \b...)
+// and keep alphabetic runs of two or more letters.
+static void collectPatternWords(const std::string& pattern, std::map<std::string, int>& freq) {
+    std::string word;
+    auto flush = [&] {
+        if (word.size() >= 2) freq[word]++;
+        word.clear();
+    };
+    for (size_t i = 0; i < pattern.size(); i++) {
+        char c = pattern[i];
+        if (c == '\\') {
+            flush();
+            i++;   // skip the escaped character
+            continue;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        } else {
+            flush();
+        }
+    }
+    flush();
+}
+
+static void collectNameWords(const std::string& name, std::map<std::string, int>& freq) {
+    std::string word;
+    for (char c : name + "_") {
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        } else {
+            if (word.size() >= 2) freq[word]++;
+            word.clear();
+        }
+    }
+}
+
+static void addTokens(whisper_context* ctx, const std::string& text, std::set<whisper_token>& out) {
+    whisper_token buf[16];
+    int n = whisper_tokenize(ctx, text.c_str(), buf, 16);
+    for (int i = 0; i < n; i++) out.insert(buf[i]);
+}
+
+static std::shared_ptr<Vocab> currentVocab(const Config& cfg) {
+    whisper_context* ctx = WhisperPool::context();
+    if (!ctx) return nullptr;
+
+    auto signature = std::make_tuple(g_nlp.rules_version(), commandMap.size(), aliases::version());
+
+    std::lock_guard<std::mutex> lock(g_vocabMutex);
+    if (g_vocab && g_vocab->signature == signature && g_vocab->bias == cfg.bias) return g_vocab;
+
+    auto aliasMap = aliases::getAll();
+
+    // Rule literals first (verbs recur across rules and rank highest),
+    // then command names, then alias keys
+    std::map<std::string, int> ruleFreq, nameFreq;
+    for (const auto& rule : g_nlp.get_rules()) collectPatternWords(rule.pattern_str, ruleFreq);
+    for (const auto& [name, _] : commandMap) collectNameWords(name, nameFreq);
+
+    std::vector<std::string> aliasKeys;
+    for (const auto& [key, _] : aliasMap) aliasKeys.push_back(key);
+    std::sort(aliasKeys.begin(), aliasKeys.end());
+    if (aliasKeys.size() > MAX_ALIAS_WORDS) aliasKeys.resize(MAX_ALIAS_WORDS);
+    for (const auto& key : aliasKeys) collectNameWords(key, nameFreq);
+
+    std::vector<std::pair<std::string, int>> ranked(ruleFreq.begin(), ruleFreq.end());
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& a, const auto& b) { return a.second > b.second; });
+    for (const auto& entry : nameFreq) {
+        if (!ruleFreq.count(entry.first)) ranked.push_back(entry);
+    }
+
+    auto vocab = std::make_shared<Vocab>();
+    vocab->signature = signature;
+    vocab->bias = cfg.bias;
+    vocab->words = ranked.size();
+
+    std::set<whisper_token> tokens;
+    for (const auto& [word, _] : ranked) {
+        std::string cap = word;
+        cap[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(cap[0])));
+        addTokens(ctx, " " + word, tokens);   // mid-sentence form
+        addTokens(ctx, " " + cap, tokens);    // sentence-initial form
+    }
+    vocab->tokens.assign(tokens.begin(), tokens.end());
+
+    for (size_t i = 0; i < ranked.size() && static_cast<int>(i) < cfg.promptWords; i++) {
+        if (!vocab->prompt.empty()) vocab->prompt += ", ";
+        vocab->prompt += ranked[i].first;
+    }
+
+    {
+        std::lock_guard<std::mutex> statsLock(g_statsMutex);
+        g_stats.vocabWords  = vocab->words;
+        g_stats.vocabTokens = vocab->tokens.size();
+    }
+    LOG_DEBUG("Whisper", "Command vocabulary: " + std::to_string(vocab->words) + " words, " +
+                         std::to_string(vocab->tokens.size()) + " tokens");
+
+    g_vocab = vocab;
+    return g_vocab;
+}
+
+// ============================================================
+// Decoding
+// ============================================================
+static void biasLogits(whisper_context*, whisper_state*, const whisper_token_data*, int,
+                       float* logits, void* userData) {
+    const auto* vocab = static_cast<const Vocab*>(userData);
+    for (whisper_token t : vocab->tokens) logits[t] += vocab->bias;
+}
+
+static std::string trimmedLower(const std::string& text) {
+    std::string out;
+    for (unsigned char c : text) out += static_cast<char>(std::tolower(c));
+    while (!out.empty() && (std::ispunct(static_cast<unsigned char>(out.back())) ||
+                            std::isspace(static_cast<unsigned char>(out.back())))) out.pop_back();
+    size_t start = out.find_first_not_of(" \t");
+    return start == std::string::npos ? "" : out.substr(start);
+}
+
+// Mean probability of the text tokens in the last decode
+static float meanTokenProb(const WhisperPool::Lease& lease) {
+    whisper_token eot = whisper_token_eot(WhisperPool::context());
+    double sum = 0.0;
+    int count = 0;
+    int segments = whisper_full_n_segments_from_state(lease.state());
+    for (int s = 0; s < segments; s++) {
+        int n = whisper_full_n_tokens_from_state(lease.state(), s);
+        for (int i = 0; i < n; i++) {
+            if (whisper_full_get_token_id_from_state(lease.state(), s, i) >= eot) continue;
+            sum += whisper_full_get_token_p_from_state(lease.state(), s, i);
+            count++;
+        }
+    }
+    return count ? static_cast<float>(sum / count) : 0.0f;
+}
+
+std::string transcribe(const std::vector<float>& pcm) {
+    if (pcm.empty()) return "";
+
+    WhisperPool::Lease lease;
+    if (!lease.valid()) return "";
+
+    Config cfg = loadConfig();
+    WhisperProfiles::Profile profile = WhisperProfiles::get();
+
+    if (cfg.enabled) {
+        if (auto vocab = currentVocab(cfg)) {
+            auto t0 = std::chrono::steady_clock::now();
+
+            whisper_full_params params = WhisperProfiles::paramsFor(profile, pcm.size());
+            params.max_tokens     = cfg.maxTokens;
+            params.single_segment = true;
+            params.initial_prompt = vocab->prompt.c_str();
+            params.logits_filter_callback           = biasLogits;
+            params.logits_filter_callback_user_data = vocab.get();
+
+            std::string text;
+            float prob = 0.0f;
+            if (lease.full(params, pcm.data(), (int)pcm.size()) == 0) {
+                text = lease.text(" ");
+                prob = meanTokenProb(lease);
+            }
+            bool accept = !text.empty() && prob >= cfg.minProb &&
+                          g_nlp.parse(trimmedLower(text)).matched;
+
+            double ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0).count();
+            {
+                std::lock_guard<std::mutex> lock(g_statsMutex);
+                g_stats.attempts++;
+                g_stats.constrainedMs += ms;
+                if (accept) g_stats.accepted++;
+            }
+
+            LOG_DEBUG("Whisper", "Constrained: \"" + text + "\" p=" + std::to_string(prob) +
+                                 (accept ? " (accepted)" : " (falling back)"));
+            if (accept) return text;
+        }
+    }
+
+    // Open-vocabulary decode with the active profile
+    auto t0 = std::chrono::steady_clock::now();
+    whisper_full_params params = WhisperProfiles::paramsFor(profile, pcm.size());
+    std::string text;
+    if (lease.full(params, pcm.data(), (int)pcm.size()) == 0) {
+        text = lease.text(" ");
+    }
+
+    if (cfg.enabled) {
+        std::lock_guard<std::mutex> lock(g_statsMutex);
+        g_stats.fallbacks++;
+        g_stats.fallbackMs += std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - t0).count();
+    }
+    return text;
+}
+
+} // namespace WhisperConstrained
@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// ============================================================
+// WhisperConstrained — command-biased decoding
+// ============================================================
+// - Vocabulary comes from NLP rule literals, command names and
+//   alias keys; its tokens get a logit boost and the words are
+//   fed as initial_prompt.
+// - A low token cap stops decoding early on short commands.
+// - The result is kept only if it parses to an intent with good
+//   token confidence; otherwise the clip is re-decoded openly.
+// ============================================================
+namespace WhisperConstrained {
+    struct Config {
+        bool  enabled   = false;
+        float bias      = 2.0f;   // logit boost for vocabulary tokens
+        int   maxTokens = 16;
+        float minProb   = 0.45f;  // mean token probability to accept
+        int   promptWords = 48;   // vocabulary words placed in initial_prompt
+    };
+
+    Config loadConfig();
+
+    struct Stats {
+        uint64_t attempts  = 0;
+        uint64_t accepted  = 0;
+        uint64_t fallbacks = 0;
+        double   constrainedMs = 0.0;
+        double   fallbackMs    = 0.0;
+        size_t   vocabWords    = 0;
+        size_t   vocabTokens   = 0;
+    };
+    Stats getStats();
+
+    // Decode a finished command clip. Uses the constrained pass when
+    // enabled and falls back to open decoding (active profile).
+    std::string transcribe(const std::vector<float>& pcm);
+}
@@ -0,0 +1,370 @@
+#include "whisper_pool.hpp"
+#include "resources.hpp"
+#include "error_manager.hpp"
+#include "logger.hpp"
+#include "voice_capture.hpp"
+#include "whisper_profiles.hpp"
+
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace WhisperPool {
+
+// ---------------- State ----------------
+static std::mutex                  g_poolMutex;
+static std::condition_variable     g_poolCV;
+static whisper_context*            g_ctx = nullptr;
+static std::vector<whisper_state*> g_free;     // idle states
+static std::vector<whisper_state*> g_all;      // every state we own
+static size_t                      g_capacity = 2;
+static Stats                       g_stats;
+
+// Background load (preload), readiness and the first-transcript marker
+static std::mutex                         g_loadMutex;
+static std::shared_future<bool>           g_loadFuture;
+static std::chrono::steady_clock::time_point g_loadStart;
+static std::atomic<bool>                  g_warm{false};             // warm-up done
+static std::atomic<bool>                  g_firstTranscript{false};
+
+// ============================================================
+// Bulk read of the model file
+// ============================================================
+// The file is mapped only for the duration of the load and handed to
+// whisper.cpp as one buffer, which copies every tensor into its own
+// memory. The weights are therefore not memory-mapped afterwards (no
+// RSS or sharing benefit); the gain is one sequential read with OS
+// read-ahead instead of many small buffered reads.
+class MappedFile {
+public:
+    explicit MappedFile(const fs::path& path) {
+#ifdef _WIN32
+        file_ = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file_, &sz) || sz.QuadPart == 0) return;
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) return;
+        data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (data_) size_ = static_cast<size_t>(sz.QuadPart);
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return;
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || st.st_size == 0) return;
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) return;
+        ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL | MADV_WILLNEED);
+        data_ = p;
+        size_ = static_cast<size_t>(st.st_size);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) ::munmap(data_, size_);
+        if (fd_ >= 0) ::close(fd_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    void*  data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void*  data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// ============================================================
+// Model load (weights only)
+// ============================================================
+static bool loadModel(const nlohmann::json& aiConfig) {
+    // Pick model name from config, default to base English
+    std::string modelName = "ggml-base.en.bin";
+    int  poolSize = 2;
+    bool bulkRead = true;
+    if (aiConfig.contains("whisper")) {
+        modelName = aiConfig["whisper"].value("whisper_model", modelName);
+        poolSize  = aiConfig["whisper"].value("pool_size", poolSize);
+        bulkRead  = aiConfig["whisper"].value("bulk_read", bulkRead);
+    }
+
+    // Resolve model path against resource root
+    fs::path modelPath = fs::path(getResourcePath()) / "models" / modelName;
+    LOG_DEBUG("WhisperPool", "Looking for Whisper model at: " + modelPath.string());
+
+    if (!fs::exists(modelPath)) {
+        LOG_ERROR("WhisperPool", "Whisper model missing: " + modelPath.string());
+        ErrorManager::report("ERR_VOICE_NOT_INITIALIZED");
+        return false;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    whisper_context_params cparams = whisper_context_default_params();
+    whisper_context* ctx = nullptr;
+
+    if (bulkRead) {
+        MappedFile mapped(modelPath);
+        if (mapped.data()) {
+            ctx = whisper_init_from_buffer_with_params_no_state(mapped.data(), mapped.size(), cparams);
+        }
+        if (!ctx) LOG_DEBUG("WhisperPool", "Bulk read unavailable, falling back to file read");
+    }
+    if (!ctx) {
+        ctx = whisper_init_from_file_with_params_no_state(modelPath.string().c_str(), cparams);
+    }
+    if (!ctx) {
+        LOG_ERROR("WhisperPool", "Failed to load Whisper model: " + modelPath.string());
+        ErrorManager::report("ERR_VOICE_TRANSCRIBE_FAIL");
+        return false;
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - t0).count();
+
+    {
+        std::lock_guard<std::mutex> lock(g_poolMutex);
+        g_ctx = ctx;
+        g_capacity = static_cast<size_t>(std::clamp(poolSize, 1, 16));
+
+        // One state up front so the first decode doesn't pay for allocation
+        if (whisper_state* st = whisper_init_state(g_ctx)) {
+            g_all.push_back(st);
+            g_free.push_back(st);
+        }
+        g_stats = Stats{};
+    }
+
+    LOG_DEBUG("WhisperPool", "Model loaded in " + std::to_string(ms) + " ms (" +
+                             std::string(bulkRead ? "bulk read" : "file read") +
+                             "), pool capacity=" + std::to_string(capacity()));
+    LOG_PHASE("Whisper model load", true);
+    return true;
+}
+
+// Run one throwaway decode so the first real utterance finds warm
+// buffers and an already-initialized compute graph.
+// The profile comes from preload's config copy: this runs on the
+// load thread, which must not read the live aiConfig.
+static void warmUp(const WhisperProfiles::Profile& profile) {
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<float> silence(VoiceCapture::SAMPLE_RATE / 2, 0.0f);
+    whisper_full_params params = WhisperProfiles::params(profile);
+    params.max_tokens = 1;
+
+    bool ok = false;
+    {
+        Lease lease;
+        ok = lease.full(params, silence.data(), (int)silence.size()) == 0;
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - t0).count();
+    LOG_DEBUG("WhisperPool", "Warm-up decode took " + std::to_string(ms) + " ms");
+    LOG_PHASE("Whisper warm-up", ok);
+}
+
+std::shared_future<bool> preload(const nlohmann::json& aiConfig) {
+    std::lock_guard<std::mutex> lock(g_loadMutex);
+    if (!g_loadFuture.valid()) {
+        g_loadStart = std::chrono::steady_clock::now();
+        g_warm = false;
+        g_firstTranscript = false;
+        g_loadFuture = std::async(std::launch::async, [cfg = aiConfig]() {
+            if (!loadModel(cfg)) return false;
+            warmUp(WhisperProfiles::get("", cfg));
+
+            // Cold start: preload kick-off → first decode possible
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - g_loadStart).count();
+            LOG_DEBUG("WhisperPool", "Ready " + std::to_string(ms) + " ms after load start (load + warm-up)");
+            LOG_PHASE("Whisper cold start → ready", true);
+            g_warm = true;
+            return true;
+        }).share();
+    }
+    return g_loadFuture;
+}
+
+bool init(const nlohmann::json& aiConfig) {
+    std::shared_future<bool> fut = preload(aiConfig);
+    bool ok = fut.get();
+    if (!ok) {
+        // Let the next call retry (model may have been copied in since)
+        std::lock_guard<std::mutex> lock(g_loadMutex);
+        if (g_loadFuture.valid() && g_loadFuture.wait_for(std::chrono::seconds(0)) ==
+                                        std::future_status::ready && !g_loadFuture.get()) {
+            g_loadFuture = {};
+        }
+    }
+    return ok;
+}
+
+bool isLoaded() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    return g_ctx != nullptr;
+}
+
+whisper_context* context() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    return g_ctx;
+}
+
+size_t capacity() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    return g_capacity;
+}
+
+void shutdown() {
+    // A background load may still be running; let it land first
+    {
+        std::shared_future<bool> fut;
+        {
+            std::lock_guard<std::mutex> loadLock(g_loadMutex);
+            fut = g_loadFuture;
+            g_loadFuture = {};
+        }
+        if (fut.valid()) fut.wait();
+    }
+
+    std::unique_lock<std::mutex> lock(g_poolMutex);
+    if (!g_ctx) return;
+
+    // Give in-flight decodes a moment to hand their states back
+    g_poolCV.wait_for(lock, std::chrono::seconds(5),
+                      [] { return g_free.size() == g_all.size(); });
+    size_t leased = g_all.size() - g_free.size();
+
+    // Only idle states are freed. A decode still running keeps its state
+    // (freed by ~Lease) and the context, which is leaked on purpose.
+    for (whisper_state* st : g_free) whisper_free_state(st);
+    g_all.clear();
+    g_free.clear();
+    if (leased == 0) {
+        whisper_free(g_ctx);
+    } else {
+        LOG_ERROR("WhisperPool", "Shutting down with " + std::to_string(leased) +
+                                 " state(s) still leased; leaking the model context");
+    }
+    g_ctx = nullptr;
+    LOG_PHASE("Whisper pool shutdown", true);
+}
+
+Stats getStats() {
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    Stats st = g_stats;
+    st.capacity = g_capacity;
+    st.created  = g_all.size();
+    st.inUse    = g_all.size() - g_free.size();
+    return st;
+}
+
+// ============================================================
+// Lease
+// ============================================================
+Lease::Lease(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(g_poolMutex);
+    if (!g_ctx) return;
+
+    // Grow lazily: each state carries its own KV cache (tens of MB)
+    if (g_free.empty() && g_all.size() < g_capacity) {
+        if (whisper_state* st = whisper_init_state(g_ctx)) {
+            g_all.push_back(st);
+            g_free.push_back(st);
+        }
+    }
+
+    if (g_free.empty()) {
+        auto t0 = std::chrono::steady_clock::now();
+        auto ready = [] { return !g_free.empty() || !g_ctx; };
+        if (timeoutMs < 0) {
+            g_poolCV.wait(lock, ready);
+        } else {
+            g_poolCV.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+        }
+        g_stats.waits++;
+        g_stats.waitMs += std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - t0).count();
+        if (g_free.empty() || !g_ctx) return;
+    }
+
+    state_ = g_free.back();
+    g_free.pop_back();
+    ctx_ = g_ctx;
+    g_stats.leases++;
+}
+
+Lease::~Lease() {
+    if (!state_) return;
+    {
+        std::lock_guard<std::mutex> lock(g_poolMutex);
+        // Outlived shutdown: the pool no longer owns this state
+        if (std::find(g_all.begin(), g_all.end(), state_) == g_all.end()) {
+            whisper_free_state(state_);
+            return;
+        }
+        g_free.push_back(state_);
+    }
+    g_poolCV.notify_all();
+}
+
+int Lease::full(const whisper_full_params& params, const float* samples, int count) {
+    if (!state_) return -1;
+    // ctx_ was taken with the state; shutdown never frees a context
+    // while a lease is out
+    auto t0 = std::chrono::steady_clock::now();
+    int rc = whisper_full_with_state(ctx_, state_, params, samples, count);
+
+    // Latency of the first real decode after warm-up (not the time
+    // the user took to start speaking)
+    if (rc == 0 && g_warm && whisper_full_n_segments_from_state(state_) > 0 &&
+        !g_firstTranscript.exchange(true)) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - t0).count();
+        LOG_DEBUG("WhisperPool", "First transcript decoded in " + std::to_string(ms) + " ms");
+        LOG_PHASE("Whisper first transcript decode", true);
+    }
+    return rc;
+}
+
+std::string Lease::text(const char* separator) const {
+    std::string out;
+    if (!state_) return out;
+    int n = whisper_full_n_segments_from_state(state_);
+    for (int i = 0; i < n; i++) {
+        if (i > 0) out += separator;
+        out += whisper_full_get_segment_text_from_state(state_, i);
+    }
+    return out;
+}
+
+} // namespace WhisperPool
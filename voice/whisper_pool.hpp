@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <future>
+#include <nlohmann/json.hpp>
+#include <whisper.h>
+
+// ============================================================
+// WhisperPool — model loaded once, decoder states leased per job
+// ============================================================
+// - Weights live in one whisper_context (no default state).
+// - Each inference checks out a whisper_state (KV cache, mel,
+//   results), so voice demo, streaming and listenOnce can decode
+//   concurrently without reloading the model.
+// - States are created lazily up to whisper.pool_size.
+// ============================================================
+namespace WhisperPool {
+    // Start loading (one bulk read where possible) + warm-up on a
+    // background thread. Repeated calls return the same readiness future.
+    std::shared_future<bool> preload(const nlohmann::json& aiConfig);
+
+    // Load the model (once) and size the pool from aiConfig["whisper"].
+    // Awaits a preload already in flight instead of loading twice.
+    bool init(const nlohmann::json& aiConfig);
+    bool isLoaded();
+    void shutdown();
+
+    // Shared model context: tokenizer/vocab only, never pass to whisper_full.
+    whisper_context* context();
+
+    size_t capacity();
+
+    struct Stats {
+        size_t   capacity = 0;
+        size_t   created  = 0;   // states allocated so far
+        size_t   inUse    = 0;
+        uint64_t leases   = 0;
+        uint64_t waits    = 0;   // leases that had to wait for a free state
+        double   waitMs   = 0.0;
+    };
+    Stats getStats();
+
+    // --------------------------------------------------------
+    // RAII checkout of one whisper_state.
+    // --------------------------------------------------------
+    class Lease {
+    public:
+        // timeoutMs < 0 waits until a state frees up.
+        explicit Lease(int timeoutMs = -1);
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        bool valid() const { return state_ != nullptr; }
+        whisper_state* state() const { return state_; }
+
+        // whisper_full_with_state on this lease; returns its rc (-1 if invalid).
+        int full(const whisper_full_params& params, const float* samples, int count);
+
+        // All segment text from the last full() call.
+        std::string text(const char* separator = "") const;
+
+    private:
+        whisper_state*   state_ = nullptr;
+        whisper_context* ctx_   = nullptr;   // the context state_ belongs to
+    };
+}
@@ -0,0 +1,195 @@
+#include "whisper_profiles.hpp"
+#include "ai/ai.hpp"
+#include "logger.hpp"
+#include "voice_capture.hpp"
+#include "whisper_pool.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+extern std::string g_whisperLanguage;
+extern int g_whisperMaxTokens;
+
+namespace WhisperProfiles {
+
+// ---------------- State ----------------
+static std::mutex  g_profileMutex;
+static std::string g_active;   // empty until first read from config
+
+static const std::vector<std::string> kNames = { "latency", "balanced", "accuracy" };
+
+std::vector<std::string> names() {
+    return kNames;
+}
+
+// ============================================================
+// Built-in presets
+// ============================================================
+static Profile builtin(const std::string& name, const nlohmann::json& config) {
+    const nlohmann::json whisperCfg =
+        (config.is_object() && config.contains("whisper")) ? config["whisper"]
+                                                           : nlohmann::json::object();
+    const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    Profile p;
+    p.name      = name;
+    // whisper.language / whisper.max_tokens, else the legacy top-level keys
+    p.language  = config.is_object() ? config.value("whisper_language", g_whisperLanguage)
+                                     : g_whisperLanguage;
+    p.maxTokens = config.is_object() ? config.value("whisper_max_tokens", g_whisperMaxTokens)
+                                     : g_whisperMaxTokens;
+    p.language  = whisperCfg.value("language", p.language);
+    p.maxTokens = whisperCfg.value("max_tokens", p.maxTokens);
+
+    if (name == "latency") {
+        p.beam           = false;
+        p.threads        = std::min(hw, 8);
+        p.maxTokens      = std::min(p.maxTokens, 24);
+        p.temperature    = 0.0f;
+        p.temperatureInc = 0.0f;
+    } else if (name == "accuracy") {
+        p.beam           = true;
+        p.beamSize       = 5;
+        p.bestOf         = 5;
+        p.threads        = std::min(hw, 8);
+        p.maxTokens      = 0;
+        p.temperature    = 0.0f;
+        p.temperatureInc = 0.2f;
+    } else {
+        // balanced: the legacy top-level whisper settings
+        p.name           = "balanced";
+        p.beam           = whisperCfg.value("sampling_strategy", "greedy") == "beam";
+        p.beamSize       = 2;
+        p.bestOf         = 2;
+        p.threads        = std::min(hw, 4);
+        p.temperature    = whisperCfg.value("temperature", 0.0f);
+        p.temperatureInc = 0.0f;
+    }
+    return p;
+}
+
+// ============================================================
+// Lookup
+// ============================================================
+// Caller holds g_profileMutex
+static std::string activeLocked(const nlohmann::json& config) {
+    if (g_active.empty()) {
+        g_active = "balanced";
+        if (config.is_object() && config.contains("whisper")) {
+            g_active = config["whisper"].value("profile", g_active);
+        }
+        if (std::find(kNames.begin(), kNames.end(), g_active) == kNames.end()) {
+            LOG_ERROR("Whisper", "Unknown profile '" + g_active + "', using balanced");
+            g_active = "balanced";
+        }
+    }
+    return g_active;
+}
+
+std::string active() {
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    return activeLocked(aiConfig);
+}
+
+bool setActive(const std::string& name) {
+    if (std::find(kNames.begin(), kNames.end(), name) == kNames.end()) return false;
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    g_active = name;
+    LOG_DEBUG("Whisper", "Decoding profile → " + name);
+    return true;
+}
+
+Profile get(const std::string& name) {
+    return get(name, aiConfig);
+}
+
+Profile get(const std::string& name, const nlohmann::json& config) {
+    std::string resolved = name;
+    if (resolved.empty()) {
+        std::lock_guard<std::mutex> lock(g_profileMutex);
+        resolved = activeLocked(config);
+    }
+    Profile p = builtin(resolved, config);
+
+    // Per-profile overrides from ai_config.json
+    if (config.is_object() && config.contains("whisper") &&
+        config["whisper"].contains("profiles") &&
+        config["whisper"]["profiles"].contains(p.name)) {
+        const auto& o = config["whisper"]["profiles"][p.name];
+        if (o.contains("strategy")) p.beam = o.value("strategy", "greedy") == "beam";
+        p.beamSize       = o.value("beam_size", p.beamSize);
+        p.bestOf         = o.value("best_of", p.bestOf);
+        p.threads        = o.value("threads", p.threads);
+        p.audioCtx       = o.value("audio_ctx", p.audioCtx);
+        p.maxTokens      = o.value("max_tokens", p.maxTokens);
+        p.temperature    = o.value("temperature", p.temperature);
+        p.temperatureInc = o.value("temperature_inc", p.temperatureInc);
+    }
+    return p;
+}
+
+// ============================================================
+// Params
+// ============================================================
+whisper_full_params params(const Profile& p) {
+    whisper_full_params wp = whisper_full_default_params(
+        p.beam ? WHISPER_SAMPLING_BEAM_SEARCH : WHISPER_SAMPLING_GREEDY);
+
+    if (p.beam) {
+        wp.beam_search.beam_size = std::max(1, p.beamSize);
+    } else {
+        wp.greedy.best_of = std::max(1, p.bestOf);
+    }
+    if (p.threads > 0) wp.n_threads = p.threads;
+
+    wp.audio_ctx       = std::max(0, p.audioCtx);
+    wp.max_tokens      = std::max(0, p.maxTokens);
+    wp.temperature     = p.temperature;
+    wp.temperature_inc = p.temperatureInc;
+    wp.language        = p.language.c_str();
+    wp.no_timestamps   = true;
+    wp.print_progress  = false;
+    wp.print_realtime  = false;
+    return wp;
+}
+
+// ============================================================
+// Short-command audio context
+// ============================================================
+// The encoder always runs over n_audio_ctx frames (1500 = 30 s)
+// unless told otherwise; a 2 s command only needs ~100 of them.
+constexpr int FRAMES_PER_SECOND = 50;
+
+int shortAudioCtx(size_t sampleCount) {
+    bool enabled = true;
+    int  maxMs    = 10000;
+    int  marginMs = 1000;
+    if (aiConfig.is_object() && aiConfig.contains("whisper") &&
+        aiConfig["whisper"].contains("short_mode")) {
+        const auto& m = aiConfig["whisper"]["short_mode"];
+        enabled  = m.value("enabled", enabled);
+        maxMs    = m.value("max_ms", maxMs);
+        marginMs = m.value("margin_ms", marginMs);
+    }
+    if (!enabled || sampleCount == 0) return 0;
+
+    long long clipMs = static_cast<long long>(sampleCount) * 1000 / VoiceCapture::SAMPLE_RATE;
+    if (clipMs > maxMs) return 0;   // long dictation keeps the full window
+
+    int frames = static_cast<int>((clipMs + std::max(0, marginMs)) * FRAMES_PER_SECOND / 1000);
+    frames = (frames + 31) / 32 * 32;  // round up to a tidy tile size
+
+    int fullCtx = 1500;
+    if (whisper_context* ctx = WhisperPool::context()) fullCtx = whisper_n_audio_ctx(ctx);
+    return frames >= fullCtx ? 0 : frames;
+}
+
+whisper_full_params paramsFor(const Profile& profile, size_t sampleCount) {
+    whisper_full_params wp = params(profile);
+    if (profile.audioCtx <= 0) wp.audio_ctx = shortAudioCtx(sampleCount);
+    return wp;
+}
+
+} // namespace WhisperProfiles
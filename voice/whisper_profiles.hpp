@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <whisper.h>
+
+// ============================================================
+// WhisperProfiles — named decoding presets for every whisper_full
+// ============================================================
+// - latency  : greedy, no fallback, all cores, tight token cap.
+// - balanced : honours whisper.sampling_strategy / temperature /
+//              whisper_max_tokens / whisper_language.
+// - accuracy : beam search with temperature fallback.
+// - Each field can be overridden in whisper.profiles.<name>;
+//   whisper.profile selects the active one.
+// ============================================================
+namespace WhisperProfiles {
+    struct Profile {
+        std::string name        = "balanced";
+        std::string language    = "en";
+        bool  beam              = false;   // beam search vs greedy
+        int   beamSize          = 2;
+        int   bestOf            = 1;
+        int   threads           = 0;       // 0 = auto
+        int   audioCtx          = 0;       // 0 = full 30 s encoder context
+        int   maxTokens         = 32;      // per segment, 0 = unlimited
+        float temperature       = 0.0f;
+        float temperatureInc    = 0.0f;    // 0 disables fallback re-decodes
+    };
+
+    std::vector<std::string> names();
+
+    // Resolve a profile by name ("" = active profile from config).
+    Profile get(const std::string& name = "");
+    // Same, from a config snapshot instead of the live aiConfig
+    // (for threads that must not read the global)
+    Profile get(const std::string& name, const nlohmann::json& config);
+
+    std::string active();
+    bool setActive(const std::string& name);
+
+    // Build params from a profile. params.language points into
+    // profile.language, so keep the profile alive across whisper_full.
+    whisper_full_params params(const Profile& profile);
+
+    // Short-command mode: encoder context sized to the clip
+    // (50 frames per second of audio + margin). Returns 0 (full
+    // context) for long dictation or when whisper.short_mode is off.
+    int shortAudioCtx(size_t sampleCount);
+
+    // params() + shortAudioCtx() unless the profile pins audio_ctx.
+    whisper_full_params paramsFor(const Profile& profile, size_t sampleCount);
+}